@@ -0,0 +1,296 @@
+#ifndef ANALYSIS_COLUMNS_H
+#define ANALYSIS_COLUMNS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "CurveHistory.h"
+#include "TaskScheduler.h"
+#include "TreasuryCsv.h"
+#include "YieldCurveLive.h"
+
+// Per-tenor risk rows of live_yield_analysis.csv (maturity, yield, duration,
+// DV01, 1Y forward, risk level) for a whole run of history, kept as columns.
+//
+// File layout (".ycol"): AnalysisFileHeader, the tenor and risk dictionaries
+// as fixed-width NUL-padded entries, then one block per column starting on a
+// 64-byte boundary at header.column_offsets[column]. Labels are stored as
+// uint8 codes into the dictionaries, and strings that are the same on every
+// row (data source, notes) are stored once in the header. Blocks are the
+// in-memory vectors written as-is, so a reader maps the file and uses them
+// in place (numpy: np.frombuffer(data, dtype, count, offset)).
+enum AnalysisColumn : size_t {
+    kAnalysisDay,          // int32 day number (days since 1970-01-01)
+    kAnalysisTenor,        // uint8 code into the tenor dictionary
+    kAnalysisRisk,         // uint8 code into the risk dictionary
+    kAnalysisMaturity,     // double, years
+    kAnalysisYield,        // double, %
+    kAnalysisDuration,     // double, years
+    kAnalysisDV01,         // double, $ per $1M per bp
+    kAnalysisForward1Y,    // double, % (0 below one year, as in the CSV)
+    kAnalysisColumnCount
+};
+
+inline constexpr size_t kAnalysisDoubleColumns = kAnalysisColumnCount - kAnalysisMaturity;
+
+inline constexpr char kAnalysisFileMagic[8] = {'Y', 'C', 'A', 'N', 'L', '\0', '\0', '\0'};
+inline constexpr uint32_t kAnalysisFileVersion = 1;
+inline constexpr uint32_t kAnalysisFileByteOrder = 0x01020304;
+inline constexpr size_t kAnalysisDictionaryWidth = 16;
+
+inline constexpr size_t kRiskLevelCount = 4;
+inline constexpr const char* kRiskLevelLabels[kRiskLevelCount] = {"LOW", "MODERATE", "HIGH", "VERY_HIGH"};
+
+inline constexpr const char* kAnalysisDataSource = "Federal_Reserve_H15";
+inline constexpr const char* kAnalysisNotes = "Federal_Reserve_H15_Official_Data";
+
+inline size_t analysisColumnWidth(size_t column) {
+    return column == kAnalysisDay ? sizeof(int32_t) : column < kAnalysisMaturity ? sizeof(uint8_t) : sizeof(double);
+}
+
+// Risk bucket by duration, as reported in the analysis CSV
+inline uint8_t riskLevelCode(double duration) {
+    return duration < 2 ? 0 : duration < 7 ? 1 : duration < 15 ? 2 : 3;
+}
+
+struct AnalysisFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t row_count;
+    uint32_t column_count;
+    uint32_t dictionary_width;
+    uint32_t tenor_dictionary_size;
+    uint32_t risk_dictionary_size;
+    uint64_t tenor_dictionary_offset;
+    uint64_t risk_dictionary_offset;
+    uint64_t column_offsets[kAnalysisColumnCount];
+    uint64_t column_checksums[kAnalysisColumnCount];
+    char data_source[32];
+    char notes[48];
+};
+
+// In-memory analysis columns, one row per (date, published tenor)
+class AnalysisColumns {
+private:
+    std::vector<int32_t> days;
+    std::vector<uint8_t> tenors;
+    std::vector<uint8_t> risks;
+    std::array<std::vector<double>, kAnalysisDoubleColumns> values;
+
+    const char* columnData(size_t column) const {
+        if (column == kAnalysisDay) return reinterpret_cast<const char*>(days.data());
+        if (column == kAnalysisTenor) return reinterpret_cast<const char*>(tenors.data());
+        if (column == kAnalysisRisk) return reinterpret_cast<const char*>(risks.data());
+        return reinterpret_cast<const char*>(values[column - kAnalysisMaturity].data());
+    }
+
+public:
+    void resize(size_t rows) {
+        days.assign(rows, 0);
+        tenors.assign(rows, 0);
+        risks.assign(rows, 0);
+        for (auto& column : values) column.assign(rows, 0.0);
+    }
+
+    size_t size() const { return days.size(); }
+    bool empty() const { return days.empty(); }
+
+    int32_t getDayNumber(size_t row) const { return days[row]; }
+    uint8_t getTenor(size_t row) const { return tenors[row]; }
+    uint8_t getRisk(size_t row) const { return risks[row]; }
+    double get(size_t row, AnalysisColumn column) const { return values[column - kAnalysisMaturity][row]; }
+
+    // Rows for every published tenor of `curve`, starting at `row`. Rows
+    // are written by exactly one worker, so different ranges need no lock.
+    void analyzeInto(size_t row, int32_t day, const CurveHistory& history, size_t history_row,
+                     const YieldCurveLive& curve) {
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+            double yield = history.getYield(history_row, tenor);
+            if (std::isnan(yield)) continue;
+
+            double maturity = kHistoryTenorYears[tenor];
+            double duration = curve.getDuration(maturity);
+            days[row] = day;
+            tenors[row] = static_cast<uint8_t>(tenor);
+            risks[row] = riskLevelCode(duration);
+            values[kAnalysisMaturity - kAnalysisMaturity][row] = maturity;
+            values[kAnalysisYield - kAnalysisMaturity][row] = yield;
+            values[kAnalysisDuration - kAnalysisMaturity][row] = duration;
+            values[kAnalysisDV01 - kAnalysisMaturity][row] = duration * 100;
+            values[kAnalysisForward1Y - kAnalysisMaturity][row] =
+                maturity >= 1.0 ? curve.getForwardRate(maturity, maturity + 1.0) : 0.0;
+            row++;
+        }
+    }
+
+    // Header and dictionaries first, then each column straight from its
+    // vector, padded to the next 64-byte boundary
+    bool writeFile(const std::string& filename) const {
+        size_t rows = size();
+        AnalysisFileHeader header{};
+        std::memcpy(header.magic, kAnalysisFileMagic, sizeof(header.magic));
+        header.version = kAnalysisFileVersion;
+        header.byte_order = kAnalysisFileByteOrder;
+        header.row_count = rows;
+        header.column_count = kAnalysisColumnCount;
+        header.dictionary_width = kAnalysisDictionaryWidth;
+        header.tenor_dictionary_size = kHistoryTenorCount;
+        header.risk_dictionary_size = kRiskLevelCount;
+        header.tenor_dictionary_offset = sizeof(header);
+        header.risk_dictionary_offset = header.tenor_dictionary_offset + kHistoryTenorCount * kAnalysisDictionaryWidth;
+        std::strncpy(header.data_source, kAnalysisDataSource, sizeof(header.data_source) - 1);
+        std::strncpy(header.notes, kAnalysisNotes, sizeof(header.notes) - 1);
+
+        size_t offset = alignHistoryCache(header.risk_dictionary_offset + kRiskLevelCount * kAnalysisDictionaryWidth);
+        for (size_t column = 0; column < kAnalysisColumnCount; column++) {
+            header.column_offsets[column] = offset;
+            header.column_checksums[column] = historyCacheChecksum(columnData(column), rows * analysisColumnWidth(column));
+            offset = alignHistoryCache(offset + rows * analysisColumnWidth(column));
+        }
+
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Error: Could not create file " << filename << std::endl;
+            return false;
+        }
+
+        std::string prefix(static_cast<size_t>(header.column_offsets[0]), '\0');
+        std::memcpy(&prefix[0], &header, sizeof(header));
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+            std::strncpy(&prefix[header.tenor_dictionary_offset + tenor * kAnalysisDictionaryWidth],
+                         kHistoryTenorLabels[tenor], kAnalysisDictionaryWidth - 1);
+        }
+        for (size_t risk = 0; risk < kRiskLevelCount; risk++) {
+            std::strncpy(&prefix[header.risk_dictionary_offset + risk * kAnalysisDictionaryWidth],
+                         kRiskLevelLabels[risk], kAnalysisDictionaryWidth - 1);
+        }
+        out.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+
+        static const char padding[kHistoryCacheAlignment] = {};
+        for (size_t column = 0; column < kAnalysisColumnCount; column++) {
+            size_t bytes = rows * analysisColumnWidth(column);
+            out.write(columnData(column), static_cast<std::streamsize>(bytes));
+            size_t end = header.column_offsets[column] + bytes;
+            out.write(padding, static_cast<std::streamsize>(alignHistoryCache(end) - end));
+        }
+
+        if (!out) {
+            std::cerr << "Error: Failed writing " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+// Analysis rows for history rows [rows.first, rows.second) on `scheduler`.
+// Published tenors are counted first so every curve knows where its rows
+// start; curves are then compiled and analyzed in parallel chunks.
+inline AnalysisColumns analyzeHistoryColumns(const CurveHistory& history, std::pair<size_t, size_t> rows,
+                                             TaskScheduler& scheduler,
+                                             InterpolationMode mode = InterpolationMode::Linear) {
+    rows.second = std::min(rows.second, history.size());
+    size_t count = rows.first < rows.second ? rows.second - rows.first : 0;
+
+    std::vector<size_t> offsets(count + 1, 0);
+    for (size_t i = 0; i < count; i++) {
+        size_t published = 0;
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+            published += std::isnan(history.getYield(rows.first + i, tenor)) ? 0 : 1;
+        }
+        offsets[i + 1] = offsets[i] + published;
+    }
+
+    AnalysisColumns table;
+    table.resize(offsets[count]);
+
+    scheduler.parallelFor(0, count, 0, [&](size_t begin, size_t end) {
+        YieldCurveLive curve;
+        curve.setInterpolationMode(mode);
+        for (size_t i = begin; i < end; i++) {
+            size_t row = rows.first + i;
+            curve.loadFromHistory(history, row);
+            table.analyzeInto(offsets[i], history.getDayNumber(row), history, row, curve);
+        }
+    });
+
+    return table;
+}
+
+// Read-only view of a ".ycol" file. Columns point straight into the mapped
+// file; nothing is parsed or copied.
+class AnalysisColumnsFile {
+private:
+    MappedFile file;
+    AnalysisFileHeader header{};
+
+    std::string_view dictionaryEntry(uint64_t offset, size_t index) const {
+        const char* entry = file.view().data() + offset + index * kAnalysisDictionaryWidth;
+        return std::string_view(entry, strnlen(entry, kAnalysisDictionaryWidth));
+    }
+
+    const char* block(AnalysisColumn column) const { return file.view().data() + header.column_offsets[column]; }
+
+public:
+    // `verify` checks every column against its stored checksum
+    bool open(const std::string& filename, bool verify = true) {
+        if (!file.open(filename) || file.size() < sizeof(AnalysisFileHeader)) {
+            std::cerr << "Error: Could not read " << filename << std::endl;
+            return false;
+        }
+        std::memcpy(&header, file.view().data(), sizeof(header));
+
+        bool valid = std::memcmp(header.magic, kAnalysisFileMagic, sizeof(header.magic)) == 0 &&
+                     header.version == kAnalysisFileVersion && header.byte_order == kAnalysisFileByteOrder &&
+                     header.column_count == kAnalysisColumnCount &&
+                     header.dictionary_width == kAnalysisDictionaryWidth &&
+                     header.tenor_dictionary_offset + header.tenor_dictionary_size * kAnalysisDictionaryWidth <=
+                         file.size() &&
+                     header.risk_dictionary_offset + header.risk_dictionary_size * kAnalysisDictionaryWidth <=
+                         file.size();
+        for (size_t column = 0; valid && column < kAnalysisColumnCount; column++) {
+            size_t bytes = static_cast<size_t>(header.row_count) * analysisColumnWidth(column);
+            valid = header.column_offsets[column] % kHistoryCacheAlignment == 0 &&
+                    header.column_offsets[column] + bytes <= file.size() &&
+                    (!verify || historyCacheChecksum(file.view().data() + header.column_offsets[column], bytes) ==
+                                    header.column_checksums[column]);
+        }
+        if (!valid) {
+            std::cerr << "Error: " << filename << " is not a valid analysis column file" << std::endl;
+            file.close();
+            return false;
+        }
+        return true;
+    }
+
+    size_t size() const { return static_cast<size_t>(header.row_count); }
+
+    const int32_t* days() const { return reinterpret_cast<const int32_t*>(block(kAnalysisDay)); }
+    const uint8_t* tenors() const { return reinterpret_cast<const uint8_t*>(block(kAnalysisTenor)); }
+    const uint8_t* risks() const { return reinterpret_cast<const uint8_t*>(block(kAnalysisRisk)); }
+    const double* column(AnalysisColumn column) const { return reinterpret_cast<const double*>(block(column)); }
+
+    std::string_view tenorLabel(uint8_t code) const {
+        return code < header.tenor_dictionary_size ? dictionaryEntry(header.tenor_dictionary_offset, code)
+                                                   : std::string_view();
+    }
+    std::string_view riskLabel(uint8_t code) const {
+        return code < header.risk_dictionary_size ? dictionaryEntry(header.risk_dictionary_offset, code)
+                                                  : std::string_view();
+    }
+    std::string_view dataSource() const {
+        return std::string_view(header.data_source, strnlen(header.data_source, sizeof(header.data_source)));
+    }
+    std::string_view notes() const { return std::string_view(header.notes, strnlen(header.notes, sizeof(header.notes))); }
+};
+
+#endif // ANALYSIS_COLUMNS_H
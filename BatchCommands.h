@@ -0,0 +1,504 @@
+#ifndef BATCH_COMMANDS_H
+#define BATCH_COMMANDS_H
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AnalysisColumns.h"
+#include "CurveHistory.h"
+#include "DashboardServer.h"
+#include "HistoryAnalytics.h"
+#include "HistoryExport.h"
+#include "QueryServer.h"
+#include "TaskScheduler.h"
+#include "TreasuryDates.h"
+#include "YieldCurveLive.h"
+
+// Non-interactive subcommands for scripts and cron jobs:
+//
+//   yield_analyzer_live analyze [--date Q]...
+//   yield_analyzer_live forward --from A --to B [--from A --to B]... [--date Q]...
+//   yield_analyzer_live spread  --from A --to B [--from A --to B]... [--date Q]...
+//   yield_analyzer_live export  --json FILE [--date D]
+//   yield_analyzer_live history [--date Q] [--ndjson] [--json FILE]
+//   yield_analyzer_live columns [--date Q] [--out FILE]
+//   yield_analyzer_live follow  [--interval S]
+//   yield_analyzer_live serve   --socket PATH [--follow]
+//   yield_analyzer_live http    [--port N] [--bind ADDR] [--docs DIR] [--follow]
+//
+// Q is any date query ("2024-07-15", "2024-07", "2024-Q3", "2024", "A..B");
+// without --date the latest curve is used. Every query runs against one load
+// of the history. Results go to stdout as CSV with a header line, errors go
+// to stderr, and the exit status is 0 on success, 1 on a data error and 2 on
+// a usage error. columns writes the per-tenor analysis rows as a binary
+// column file (AnalysisColumns.h) instead of CSV.
+//
+// follow, serve and http stay resident until SIGINT or SIGTERM. follow prints
+// the analyze row of the latest curve, then one row for every curve appended
+// to (or revised in) the CSV; serve answers the CurveQueryServer line
+// protocol, http serves the dashboard and its JSON endpoints
+// (DashboardHttpServer). With --follow the servers pick up appended rows the
+// same way (CurveHistory::refreshFromCSV).
+//
+// Global options, accepted before or after the subcommand: --csv FILE,
+// --mapping FILE (header label -> maturity JSON, default
+// maturity_mapping_live.json next to the CSV), --spline, --threads N,
+// --interval S (seconds between CSV checks, default 5).
+
+enum class BatchCommand {
+    None,
+    Analyze,
+    Forward,
+    Spread,
+    Export,
+    History,
+    Columns,
+    Follow,
+    Serve,
+    Http
+};
+
+inline BatchCommand parseBatchCommand(const std::string& name) {
+    if (name == "analyze") return BatchCommand::Analyze;
+    if (name == "forward") return BatchCommand::Forward;
+    if (name == "spread") return BatchCommand::Spread;
+    if (name == "export") return BatchCommand::Export;
+    if (name == "history") return BatchCommand::History;
+    if (name == "columns") return BatchCommand::Columns;
+    if (name == "follow") return BatchCommand::Follow;
+    if (name == "serve") return BatchCommand::Serve;
+    if (name == "http") return BatchCommand::Http;
+    return BatchCommand::None;
+}
+
+struct BatchOptions {
+    BatchCommand command = BatchCommand::None;
+    std::string csv_file = "treasury_yields_live.csv";
+    std::string mapping_file;   // empty: maturity_mapping_live.json next to the CSV
+    InterpolationMode interpolation = InterpolationMode::Linear;
+    unsigned workers = 0;
+    std::vector<std::string> dates;
+    std::vector<double> from;
+    std::vector<double> to;
+    std::string json_file;
+    HistoryJsonFormat history_format = HistoryJsonFormat::Columns;
+    std::string out_file = "live_yield_analysis.ycol";
+    std::string socket_path;
+    std::string bind_address = "127.0.0.1";
+    int port = 8080;
+    std::string docs_dir = "docs";
+    bool follow = false;
+    double interval = 5.0;   // seconds between CSV checks when following
+};
+
+inline constexpr int kBatchExitOk = 0;
+inline constexpr int kBatchExitDataError = 1;
+inline constexpr int kBatchExitUsage = 2;
+
+inline void printBatchUsage(std::ostream& out) {
+    out << "Usage: yield_analyzer_live [analyze|forward|spread|export|history|columns|follow|serve|http] [options]\n"
+        << "  analyze [--date Q]...                          full analysis per curve\n"
+        << "  forward --from A --to B [...] [--date Q]...     forward rates (%)\n"
+        << "  spread  --from A --to B [...] [--date Q]...     yield spreads (bps)\n"
+        << "  export  --json FILE [--date D]                  dashboard JSON\n"
+        << "  history [--date Q] [--ndjson] [--json FILE]     every curve as JSON (default stdout)\n"
+        << "  columns [--date Q] [--out FILE]                 analysis rows as binary columns\n"
+        << "  follow  [--interval S]                          analysis rows as curves are appended\n"
+        << "  serve   --socket PATH [--follow]                resident query server\n"
+        << "  http    [--port N] [--bind ADDR] [--docs DIR]   dashboard + JSON endpoints\n"
+        << "          [--follow]\n"
+        << "Options: --csv FILE, --mapping FILE, --spline, --threads N, --interval S\n"
+        << "Without a subcommand, yield_analyzer_live [CSV_FILE] opens the interactive menu\n"
+        << "Dates: YYYY-MM-DD, YYYY-MM, YYYY, YYYY-Qn or A..B (default: latest curve)\n";
+}
+
+namespace batch_detail {
+
+inline bool parseMaturity(const char* text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end != text && *end == '\0' && value >= 0.0;
+}
+
+// History rows selected by one date query. A single day with no release
+// (weekend, holiday) falls back to the curve in force that day, as the
+// interactive menu does.
+inline bool resolveRows(const CurveHistory& history, const std::string& query,
+                        std::pair<size_t, size_t>& rows) {
+    if (query.empty()) {
+        rows = {history.latestRow(), history.latestRow() + 1};
+        return !history.empty();
+    }
+
+    DateRange range;
+    if (!parseDateQuery(query, range)) {
+        std::cerr << "Error: Invalid date '" << query << "' (use YYYY-MM-DD, YYYY-MM, YYYY, YYYY-Qn or A..B)"
+                  << std::endl;
+        return false;
+    }
+
+    rows = history.findRange(range);
+    if (rows.first >= rows.second && range.single_day) {
+        size_t row = history.findNearestPrior(range.first);
+        if (row < history.size()) rows = {row, row + 1};
+    }
+    if (rows.first >= rows.second) {
+        std::cerr << "Error: No yield curve data found for " << query << std::endl;
+        return false;
+    }
+    return true;
+}
+
+inline void appendNumber(std::string& line, double value, const char* format = "%.4f") {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), format, value);
+    line.append(buffer, static_cast<size_t>(length));
+}
+
+// forward/spread: one line per (curve, maturity pair)
+inline int runPairs(const BatchOptions& options, const CurveHistory& history) {
+    bool forward = options.command == BatchCommand::Forward;
+    std::vector<std::string> queries = options.dates.empty() ? std::vector<std::string>{""} : options.dates;
+
+    std::string line = forward ? "Date,From,To,Forward_Pct\n" : "Date,From,To,Spread_bps\n";
+    std::cout << line;
+
+    YieldCurveLive curve;
+    curve.setInterpolationMode(options.interpolation);
+    for (const auto& query : queries) {
+        std::pair<size_t, size_t> rows;
+        if (!resolveRows(history, query, rows)) return kBatchExitDataError;
+
+        for (size_t row = rows.first; row < rows.second; row++) {
+            curve.loadFromHistory(history, row);
+            line.clear();
+            for (size_t i = 0; i < options.from.size(); i++) {
+                double value = forward ? curve.getForwardRate(options.from[i], options.to[i])
+                                       : curve.getSpread(options.from[i], options.to[i]) * 100;
+                line += curve.getDate();
+                line += ',';
+                appendNumber(line, options.from[i], "%g");
+                line += ',';
+                appendNumber(line, options.to[i], "%g");
+                line += ',';
+                appendNumber(line, value);
+                line += '\n';
+            }
+            std::cout << line;
+        }
+    }
+    return kBatchExitOk;
+}
+
+inline int runAnalyze(const BatchOptions& options, const CurveHistory& history, TaskScheduler& scheduler) {
+    std::vector<std::string> queries = options.dates.empty() ? std::vector<std::string>{""} : options.dates;
+
+    bool header = true;
+    for (const auto& query : queries) {
+        std::pair<size_t, size_t> rows;
+        if (!resolveRows(history, query, rows)) return kBatchExitDataError;
+
+        analyzeHistory(history, rows, scheduler, options.interpolation).writeCSV(std::cout, header);
+        header = false;
+    }
+    return kBatchExitOk;
+}
+
+inline int runExport(const BatchOptions& options, const CurveHistory& history) {
+    std::pair<size_t, size_t> rows;
+    if (!resolveRows(history, options.dates.empty() ? "" : options.dates.front(), rows)) {
+        return kBatchExitDataError;
+    }
+
+    YieldCurveLive curve;
+    curve.setInterpolationMode(options.interpolation);
+    curve.loadFromHistory(history, rows.first);
+
+    if (options.json_file == "-") {
+        curve.writeJSON(std::cout);
+        return kBatchExitOk;
+    }
+
+    std::ofstream file(options.json_file);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create file " << options.json_file << std::endl;
+        return kBatchExitDataError;
+    }
+    curve.writeJSON(file);
+    return file ? kBatchExitOk : kBatchExitDataError;
+}
+
+// history: all curves by default; columnar JSON or NDJSON to a file or stdout
+inline int runHistory(const BatchOptions& options, const CurveHistory& history, TaskScheduler& scheduler) {
+    std::pair<size_t, size_t> rows{0, history.size()};
+    if (!options.dates.empty() && !resolveRows(history, options.dates.front(), rows)) return kBatchExitDataError;
+
+    std::string filename = options.json_file.empty() ? "-" : options.json_file;
+    return exportHistoryJSON(history, rows, filename, options.history_format, &scheduler) > 0 ? kBatchExitOk
+                                                                                              : kBatchExitDataError;
+}
+
+// columns: all curves by default, one row per published tenor per curve
+inline int runColumns(const BatchOptions& options, const CurveHistory& history, TaskScheduler& scheduler) {
+    std::pair<size_t, size_t> rows{0, history.size()};
+    if (!options.dates.empty() && !resolveRows(history, options.dates.front(), rows)) return kBatchExitDataError;
+
+    AnalysisColumns table = analyzeHistoryColumns(history, rows, scheduler, options.interpolation);
+    return table.writeFile(options.out_file) ? kBatchExitOk : kBatchExitDataError;
+}
+
+inline CurveQueryServer* active_query_server = nullptr;
+inline DashboardHttpServer* active_http_server = nullptr;
+inline volatile std::sig_atomic_t follow_stop_requested = 0;
+
+inline void stopActiveServer(int) {
+    if (active_query_server) active_query_server->stop();
+    if (active_http_server) active_http_server->stop();
+    follow_stop_requested = 1;
+}
+
+// Re-reads the CSV behind a loaded history at most once per interval
+class HistoryFollower {
+private:
+    CurveHistory& history;
+    std::string csv_file;
+    TaskScheduler& scheduler;
+    std::chrono::steady_clock::duration interval;
+    std::chrono::steady_clock::time_point next_check;
+
+public:
+    HistoryFollower(CurveHistory& target, const BatchOptions& options, TaskScheduler& workers)
+        : history(target), csv_file(options.csv_file), scheduler(workers),
+          interval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(std::max(0.0, options.interval)))),
+          next_check(std::chrono::steady_clock::now() + interval) {}
+
+    // True when rows changed, from `first_changed` on. A file that can no
+    // longer be read keeps the rows already loaded.
+    bool poll(size_t& first_changed) {
+        auto now = std::chrono::steady_clock::now();
+        if (now < next_check) return false;
+        next_check = now + interval;
+
+        if (!history.refreshFromCSV(csv_file, first_changed, &scheduler) || first_changed >= history.size()) {
+            return false;
+        }
+        std::cerr << "Refreshed " << csv_file << ": " << history.size() << " curves, changed from "
+                  << history.getDate(first_changed) << " to " << history.getDate(history.latestRow()) << std::endl;
+        return true;
+    }
+};
+
+// follow: the latest analyze row, then every row that changes in the CSV
+inline int runFollow(const BatchOptions& options, CurveHistory& history, TaskScheduler& scheduler) {
+    HistoryAnalysisTable table = analyzeHistory(history, {0, history.size()}, scheduler, options.interpolation);
+    table.writeCSV(std::cout, true, table.size() - 1);
+    std::cout.flush();
+
+    follow_stop_requested = 0;
+    std::signal(SIGINT, stopActiveServer);
+    std::signal(SIGTERM, stopActiveServer);
+
+    HistoryFollower follower(history, options, scheduler);
+    while (!follow_stop_requested && std::cout) {
+        size_t first_changed;
+        if (follower.poll(first_changed)) {
+            updateHistoryAnalysis(table, history, first_changed, scheduler, options.interpolation);
+            table.writeCSV(std::cout, false, first_changed);
+            std::cout.flush();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    return std::cout ? kBatchExitOk : kBatchExitDataError;
+}
+
+inline int runServe(const BatchOptions& options, CurveHistory& history, TaskScheduler& scheduler) {
+    CurveQueryServer server(history, options.interpolation);
+    if (!server.listen(options.socket_path)) return kBatchExitDataError;
+
+    HistoryFollower follower(history, options, scheduler);
+    if (options.follow) {
+        server.setIdleTask([&] {
+            size_t first_changed;
+            if (follower.poll(first_changed)) server.historyChanged(first_changed);
+        });
+    }
+
+    active_query_server = &server;
+    std::signal(SIGINT, stopActiveServer);
+    std::signal(SIGTERM, stopActiveServer);
+    std::cerr << "Serving " << history.size() << " curves on " << options.socket_path << std::endl;
+
+    server.run();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    active_query_server = nullptr;
+    return kBatchExitOk;
+}
+
+inline int runHttp(const BatchOptions& options, CurveHistory& history, TaskScheduler& scheduler) {
+    DashboardHttpServer server(history, options.docs_dir, options.interpolation);
+    if (!server.listen(options.bind_address, options.port)) return kBatchExitDataError;
+
+    // Responses are keyed on the history revision, so a refresh is all the
+    // dashboard needs to serve the new rows
+    HistoryFollower follower(history, options, scheduler);
+    if (options.follow) {
+        server.setIdleTask([&] {
+            size_t first_changed;
+            follower.poll(first_changed);
+        });
+    }
+
+    active_http_server = &server;
+    std::signal(SIGINT, stopActiveServer);
+    std::signal(SIGTERM, stopActiveServer);
+    std::cerr << "Serving " << options.docs_dir << " and " << history.size() << " curves on http://"
+              << options.bind_address << ":" << server.port() << "/" << std::endl;
+
+    server.run();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    active_http_server = nullptr;
+    return kBatchExitOk;
+}
+
+} // namespace batch_detail
+
+// Parses argv[1..] into `options`. Returns false (after printing why) on a
+// usage error.
+inline bool parseBatchArguments(int argc, char* argv[], BatchOptions& options) {
+    std::string bare_word;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (options.command == BatchCommand::None && parseBatchCommand(arg) != BatchCommand::None) {
+            options.command = parseBatchCommand(arg);
+        } else if (arg == "--ndjson") {
+            options.history_format = HistoryJsonFormat::NDJSON;
+        } else if (arg == "--follow") {
+            options.follow = true;
+        } else if (arg == "--spline") {
+            options.interpolation = InterpolationMode::CubicSpline;
+        } else if (arg == "--threads" && has_value) {
+            options.workers = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--interval" && has_value) {
+            options.interval = std::atof(argv[++i]);
+            if (!(options.interval > 0.0)) {
+                std::cerr << "Error: Invalid interval '" << argv[i] << "' (seconds)" << std::endl;
+                return false;
+            }
+        } else if (arg == "--csv" && has_value) {
+            options.csv_file = argv[++i];
+        } else if (arg == "--mapping" && has_value) {
+            options.mapping_file = argv[++i];
+        } else if (arg == "--date" && has_value) {
+            options.dates.push_back(argv[++i]);
+        } else if (arg == "--socket" && has_value) {
+            options.socket_path = argv[++i];
+        } else if (arg == "--port" && has_value) {
+            options.port = std::atoi(argv[++i]);
+        } else if (arg == "--bind" && has_value) {
+            options.bind_address = argv[++i];
+        } else if (arg == "--docs" && has_value) {
+            options.docs_dir = argv[++i];
+        } else if (arg == "--out" && has_value) {
+            options.out_file = argv[++i];
+        } else if (arg == "--json" && has_value) {
+            options.json_file = argv[++i];
+        } else if ((arg == "--from" || arg == "--to") && has_value) {
+            double maturity;
+            if (!batch_detail::parseMaturity(argv[++i], maturity)) {
+                std::cerr << "Error: Invalid maturity '" << argv[i] << "' for " << arg << std::endl;
+                return false;
+            }
+            (arg == "--from" ? options.from : options.to).push_back(maturity);
+        } else if (options.command == BatchCommand::None && arg.rfind("--", 0) != 0 && bare_word.empty()) {
+            bare_word = arg;   // Interactive mode: bare CSV filename, checked below
+        } else {
+            std::cerr << "Error: Unknown or incomplete argument '" << arg << "'" << std::endl;
+            return false;
+        }
+    }
+
+    // A bare word only opens the interactive menu when it names a file;
+    // anything else is far more likely a mistyped subcommand
+    if (options.command == BatchCommand::None && !bare_word.empty()) {
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(bare_word, ec)) {
+            std::cerr << "Error: Unknown subcommand or CSV file '" << bare_word << "'" << std::endl;
+            return false;
+        }
+        options.csv_file = bare_word;
+    }
+
+    switch (options.command) {
+        case BatchCommand::Forward:
+        case BatchCommand::Spread:
+            if (options.from.empty() || options.from.size() != options.to.size()) {
+                std::cerr << "Error: " << (options.command == BatchCommand::Forward ? "forward" : "spread")
+                          << " needs matching --from/--to pairs" << std::endl;
+                return false;
+            }
+            break;
+        case BatchCommand::Export:
+            if (options.json_file.empty()) {
+                std::cerr << "Error: export needs --json FILE (or --json - for stdout)" << std::endl;
+                return false;
+            }
+            break;
+        case BatchCommand::Serve:
+            if (options.socket_path.empty()) {
+                std::cerr << "Error: serve needs --socket PATH" << std::endl;
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+// Runs one parsed subcommand against an already-loaded history; follow and
+// the servers with --follow refresh it from the CSV as it grows
+inline int runBatchCommand(const BatchOptions& options, CurveHistory& history, TaskScheduler& scheduler) {
+    switch (options.command) {
+        case BatchCommand::Analyze:
+            return batch_detail::runAnalyze(options, history, scheduler);
+        case BatchCommand::Forward:
+        case BatchCommand::Spread:
+            return batch_detail::runPairs(options, history);
+        case BatchCommand::Export:
+            return batch_detail::runExport(options, history);
+        case BatchCommand::History:
+            return batch_detail::runHistory(options, history, scheduler);
+        case BatchCommand::Columns:
+            return batch_detail::runColumns(options, history, scheduler);
+        case BatchCommand::Follow:
+            return batch_detail::runFollow(options, history, scheduler);
+        case BatchCommand::Serve:
+            return batch_detail::runServe(options, history, scheduler);
+        case BatchCommand::Http:
+            return batch_detail::runHttp(options, history, scheduler);
+        default:
+            return kBatchExitUsage;
+    }
+}
+
+#endif // BATCH_COMMANDS_H
@@ -0,0 +1,903 @@
+#ifndef CURVE_HISTORY_H
+#define CURVE_HISTORY_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "TaskScheduler.h"
+#include "TreasuryCsv.h"
+#include "TreasuryDates.h"
+
+// Treasury constant-maturity tenors a history can hold, in maturity order:
+// the H.15 set plus the 1.5-, 2- and 4-month bills that newer files carry.
+// A file fills the tenors its header names (CsvColumnMap); the rest stay NaN.
+inline constexpr size_t kHistoryTenorCount = 14;
+inline constexpr const char* kHistoryTenorLabels[kHistoryTenorCount] = {
+    "1MO", "1.5MO", "2MO", "3MO", "4MO", "6MO", "1Y", "2Y", "3Y", "5Y", "7Y", "10Y", "20Y", "30Y"
+};
+inline constexpr double kHistoryTenorYears[kHistoryTenorCount] = {
+    1.0/12.0, 1.5/12.0, 2.0/12.0, 0.25, 4.0/12.0, 0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0, 20.0, 30.0
+};
+
+// Interned tenor: an index into the tables above. Curves carry the id and
+// look the label up only when printing or exporting.
+using TenorId = uint8_t;
+inline constexpr TenorId kNoTenor = 0xFF;
+
+inline constexpr std::string_view tenorLabel(TenorId tenor) {
+    return tenor < kHistoryTenorCount ? std::string_view(kHistoryTenorLabels[tenor]) : std::string_view();
+}
+
+// kNoTenor when `label` is not an H.15 column
+inline constexpr TenorId findTenor(std::string_view label) {
+    for (size_t i = 0; i < kHistoryTenorCount; i++) {
+        if (label == kHistoryTenorLabels[i]) return static_cast<TenorId>(i);
+    }
+    return kNoTenor;
+}
+
+// Curves rely on the table being in maturity order with unique labels
+inline constexpr bool tenorTableConsistent() {
+    for (size_t i = 0; i < kHistoryTenorCount; i++) {
+        if (findTenor(kHistoryTenorLabels[i]) != i) return false;
+        if (i > 0 && kHistoryTenorYears[i] <= kHistoryTenorYears[i - 1]) return false;
+    }
+    return true;
+}
+static_assert(tenorTableConsistent(), "H.15 tenor table must be unique and sorted by maturity");
+static_assert(kHistoryTenorCount <= 32, "tenor sets are kept as 32-bit masks");
+
+// On-disk snapshot of a parsed history, written next to the CSV as
+// "<csv>.ycache". Layout: header, fixed-width date index, then one yield block
+// per tenor, each starting on a 64-byte boundary so the columns can be mapped
+// and fed to SIMD loads directly.
+inline constexpr char kHistoryCacheMagic[8] = {'Y', 'C', 'H', 'I', 'S', 'T', '\0', '\0'};
+inline constexpr uint32_t kHistoryCacheVersion = 3;
+inline constexpr uint32_t kHistoryCacheByteOrder = 0x01020304;
+inline constexpr size_t kHistoryCacheAlignment = 64;
+inline constexpr size_t kHistoryCacheDateWidth = 16;
+
+struct HistoryCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t tenor_count;
+    uint32_t date_width;
+    uint64_t row_count;
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t columns_offset;
+    uint64_t column_stride;
+    uint64_t column_layout;   // CsvColumnMap::layoutHash of the parsed header
+    uint64_t payload_checksum;
+};
+
+inline size_t alignHistoryCache(size_t offset) {
+    return (offset + kHistoryCacheAlignment - 1) & ~(kHistoryCacheAlignment - 1);
+}
+
+// Word-at-a-time hash used to detect truncated or corrupted cache payloads
+inline uint64_t historyCacheChecksum(const char* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// kNoTenor when no table tenor has this maturity
+inline TenorId findTenorByMaturity(double years) {
+    for (size_t i = 0; i < kHistoryTenorCount; i++) {
+        if (std::abs(kHistoryTenorYears[i] - years) < 1e-6) return static_cast<TenorId>(i);
+    }
+    return kNoTenor;
+}
+
+// Header labels compare without case, blanks or quotes: "1 Mo" is "1MO"
+inline std::string normalizeTenorLabel(std::string_view label) {
+    std::string normalized;
+    normalized.reserve(label.size());
+    for (char c : label) {
+        if (c == ' ' || c == '\t' || c == '\r' || c == '"') continue;
+        normalized += (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    return normalized;
+}
+
+inline constexpr const char* kTenorMappingFile = "maturity_mapping_live.json";
+
+// Header label -> maturity in years, read from a flat JSON object such as
+// maturity_mapping_live.json ({"1MO": 0.0833, "3MO": 0.25, ...}). Labels it
+// does not list fall back to the table labels above. Tenor slots are the
+// compile-time table, so every maturity in the file must be one of its
+// tenors; any other maturity is rejected rather than dropped.
+class TenorMapping {
+private:
+    std::vector<std::pair<std::string, double>> entries;   // normalized labels
+
+    static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    static void skipBlanks(std::string_view text, size_t& pos) {
+        while (pos < text.size() && isBlank(text[pos])) pos++;
+    }
+
+    // Only what the mapping file needs: string keys without escapes and
+    // positive numbers
+    bool parse(std::string_view text) {
+        size_t pos = 0;
+        skipBlanks(text, pos);
+        if (pos >= text.size() || text[pos++] != '{') return false;
+        skipBlanks(text, pos);
+        if (pos < text.size() && text[pos] == '}') return true;
+
+        while (pos < text.size()) {
+            if (text[pos++] != '"') return false;
+            size_t quote = text.find('"', pos);
+            if (quote == std::string_view::npos) return false;
+            std::string_view label = text.substr(pos, quote - pos);
+            if (label.find('\\') != std::string_view::npos) return false;
+            pos = quote + 1;
+
+            skipBlanks(text, pos);
+            if (pos >= text.size() || text[pos++] != ':') return false;
+            size_t end = text.find_first_of(",}", pos);
+            if (end == std::string_view::npos) return false;
+            // The last value runs up to a line break before '}'
+            std::string_view number = text.substr(pos, end - pos);
+            while (!number.empty() && isBlank(number.front())) number.remove_prefix(1);
+            while (!number.empty() && isBlank(number.back())) number.remove_suffix(1);
+            double years;
+            if (parseCsvValue(number, years) != CsvValueStatus::Ok || years <= 0.0) {
+                return false;
+            }
+            entries.emplace_back(normalizeTenorLabel(label), years);
+
+            pos = end + 1;
+            if (text[end] == '}') {
+                skipBlanks(text, pos);
+                return pos == text.size();
+            }
+            skipBlanks(text, pos);
+        }
+        return false;
+    }
+
+public:
+    bool loadFromJSON(const std::string& filename) {
+        entries.clear();
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            std::cerr << "Error: Could not open maturity mapping " << filename << std::endl;
+            return false;
+        }
+        if (!parse(file.view())) {
+            entries.clear();
+            std::cerr << "Error: Invalid maturity mapping in " << filename
+                      << " (expected {\"LABEL\": years, ...})" << std::endl;
+            return false;
+        }
+        for (const auto& entry : entries) {
+            if (findTenorByMaturity(entry.second) != kNoTenor) continue;
+            std::cerr << "Error: Maturity mapping " << filename << " maps '" << entry.first << "' to "
+                      << entry.second << " years, which is not a supported tenor (";
+            for (size_t i = 0; i < kHistoryTenorCount; i++) std::cerr << (i ? " " : "") << kHistoryTenorLabels[i];
+            std::cerr << ")" << std::endl;
+            entries.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // Tenor for a normalized header label, kNoTenor if unknown
+    TenorId tenorOf(std::string_view label) const {
+        for (const auto& entry : entries) {
+            if (entry.first == label) return findTenorByMaturity(entry.second);
+        }
+        return findTenor(label);
+    }
+};
+
+// The mapping for `csv_file`: `mapping_file` when given, otherwise
+// maturity_mapping_live.json next to the CSV, otherwise the table labels
+inline bool loadTenorMappingFor(const std::string& csv_file, const std::string& mapping_file,
+                                TenorMapping& mapping) {
+    mapping = TenorMapping();
+    if (!mapping_file.empty()) return mapping.loadFromJSON(mapping_file);
+
+    std::error_code ec;
+    std::string beside_csv = (std::filesystem::path(csv_file).parent_path() / kTenorMappingFile).string();
+    if (!std::filesystem::exists(beside_csv, ec)) return true;
+    return mapping.loadFromJSON(beside_csv);
+}
+
+// Where each tenor sits in one CSV file, resolved once from its header so
+// the row loop only indexes: the date first, then any tenor columns in any
+// order. Columns whose label the mapping does not list are ignored with a
+// warning, and tenors the file lacks are simply not in `tenors`.
+inline constexpr size_t kCsvDateColumn = 0;
+
+struct CsvColumnMap {
+    struct Column {
+        uint32_t field;
+        TenorId tenor;
+    };
+    std::vector<Column> tenors;   // in header order
+    size_t min_fields = 0;        // a data row needs at least this many fields
+    uint32_t tenor_mask = 0;      // bit i set when tenor i has a column
+
+    bool resolve(std::string_view header, const TenorMapping& mapping, const std::string& filename) {
+        tenors.clear();
+        tenor_mask = 0;
+        min_fields = kCsvDateColumn + 1;
+
+        CsvFields fields;
+        splitCsvFields(header, fields);
+        for (size_t field = 0; field < fields.size(); field++) {
+            std::string label = normalizeTenorLabel(fields[field]);
+            if (field == kCsvDateColumn) continue;
+            if (label == "DATE") {
+                std::cerr << "Error: The date must be the first column of " << filename << std::endl;
+                return false;
+            }
+
+            TenorId tenor = mapping.tenorOf(label);
+            if (tenor == kNoTenor) {
+                std::cerr << "Warning: Ignoring column '" << fields[field] << "' in " << filename
+                          << " (not in the maturity mapping)" << std::endl;
+                continue;
+            }
+            if (tenor_mask & (1u << tenor)) {
+                std::cerr << "Warning: Ignoring duplicate " << kHistoryTenorLabels[tenor] << " column '"
+                          << fields[field] << "' in " << filename << std::endl;
+                continue;
+            }
+            tenors.push_back(Column{static_cast<uint32_t>(field), tenor});
+            tenor_mask |= 1u << tenor;
+            min_fields = field + 1;
+        }
+
+        if (tenors.empty()) {
+            std::cerr << "Error: No tenor columns in the header of " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Identifies the layout a snapshot cache was parsed with
+    uint64_t layoutHash() const {
+        std::vector<uint32_t> packed;
+        packed.reserve(tenors.size());
+        for (const auto& column : tenors) packed.push_back(column.field << 8 | column.tenor);
+        return historyCacheChecksum(reinterpret_cast<const char*>(packed.data()), packed.size() * sizeof(uint32_t));
+    }
+};
+
+// Resolve the header line of `csv_file` against its tenor mapping
+inline bool resolveCsvColumns(const std::string& csv_file, std::string_view header, const std::string& mapping_file,
+                              CsvColumnMap& map) {
+    TenorMapping mapping;
+    return loadTenorMappingFor(csv_file, mapping_file, mapping) && map.resolve(header, mapping, csv_file);
+}
+
+// Whole yield history parsed once into structure-of-arrays columns: one date
+// array plus one contiguous yield array per tenor. Missing observations are
+// stored as NaN so every column stays aligned with the date array. Dates are
+// also kept as sorted day numbers, which is what all lookups search.
+class CurveHistory {
+private:
+    std::vector<std::string> dates;
+    std::vector<int32_t> day_numbers;
+    std::array<std::vector<double>, kHistoryTenorCount> columns;
+    CsvColumnMap column_map;    // layout of the file the rows came from
+    std::string mapping_file;   // empty: maturity_mapping_live.json beside the CSV
+    bool cache_enabled = true;
+
+    // Tail-follow state: the file the rows came from, the offset just past
+    // its last complete line and that line's text, and the stamp seen at the
+    // last load or refresh
+    std::string source_file;
+    size_t parsed_offset = 0;
+    std::string parsed_tail;
+    uint64_t source_size_seen = 0;
+    int64_t source_mtime_seen = 0;
+    uint64_t revision_ = 0;
+
+    void clear() {
+        dates.clear();
+        day_numbers.clear();
+        for (auto& column : columns) column.clear();
+    }
+
+    // Rows are expected in date order; reorder them if a file arrives shuffled
+    void sortByDate() {
+        if (std::is_sorted(day_numbers.begin(), day_numbers.end())) return;
+
+        std::vector<size_t> order(dates.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [this](size_t a, size_t b) { return day_numbers[a] < day_numbers[b]; });
+
+        std::vector<std::string> sorted_dates(dates.size());
+        std::vector<int32_t> sorted_days(dates.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            sorted_dates[i] = std::move(dates[order[i]]);
+            sorted_days[i] = day_numbers[order[i]];
+        }
+        dates = std::move(sorted_dates);
+        day_numbers = std::move(sorted_days);
+
+        for (auto& column : columns) {
+            std::vector<double> sorted_column(column.size());
+            for (size_t i = 0; i < order.size(); i++) sorted_column[i] = column[order[i]];
+            column = std::move(sorted_column);
+        }
+    }
+
+    // After sortByDate: keep only the last row of each date, so a provisional
+    // row superseded later in the file loads the way refreshFromCSV merges it
+    void collapseDuplicateDates() {
+        if (std::adjacent_find(day_numbers.begin(), day_numbers.end()) == day_numbers.end()) return;
+
+        size_t kept = 0;
+        for (size_t row = 0; row < day_numbers.size(); row++) {
+            if (row + 1 < day_numbers.size() && day_numbers[row + 1] == day_numbers[row]) continue;
+            if (kept != row) {
+                dates[kept] = std::move(dates[row]);
+                day_numbers[kept] = day_numbers[row];
+                for (auto& column : columns) column[kept] = column[row];
+            }
+            kept++;
+        }
+        dates.resize(kept);
+        day_numbers.resize(kept);
+        for (auto& column : columns) column.resize(kept);
+    }
+
+    // Size and modification time identify the CSV revision a cache was built from
+    static bool sourceStamp(const std::string& filename, uint64_t& size, int64_t& mtime) {
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(filename, ec);
+        if (ec) return false;
+        auto write_time = std::filesystem::last_write_time(filename, ec);
+        if (ec) return false;
+
+        size = static_cast<uint64_t>(file_size);
+        mtime = static_cast<int64_t>(write_time.time_since_epoch().count());
+        return true;
+    }
+
+    bool loadCache(const std::string& cache_file, uint64_t source_size, int64_t source_mtime, uint64_t layout) {
+        MappedFile file(cache_file);
+        if (!file.isOpen() || file.size() < sizeof(HistoryCacheHeader)) return false;
+
+        const char* base = file.view().data();
+        HistoryCacheHeader header;
+        std::memcpy(&header, base, sizeof(header));
+
+        if (std::memcmp(header.magic, kHistoryCacheMagic, sizeof(header.magic)) != 0 ||
+            header.version != kHistoryCacheVersion ||
+            header.byte_order != kHistoryCacheByteOrder ||
+            header.tenor_count != kHistoryTenorCount ||
+            header.date_width != kHistoryCacheDateWidth ||
+            header.source_size != source_size ||
+            header.source_mtime != source_mtime ||
+            header.column_layout != layout) {
+            return false;
+        }
+
+        size_t rows = static_cast<size_t>(header.row_count);
+        if (header.column_stride < rows * sizeof(double) ||
+            header.columns_offset < sizeof(header) + rows * kHistoryCacheDateWidth ||
+            file.size() < header.columns_offset + kHistoryTenorCount * header.column_stride) {
+            return false;
+        }
+
+        size_t payload_size = file.size() - sizeof(header);
+        if (historyCacheChecksum(base + sizeof(header), payload_size) != header.payload_checksum) {
+            return false;
+        }
+
+        clear();
+        dates.reserve(rows);
+        day_numbers.resize(rows);
+        const char* date_index = base + sizeof(header);
+        for (size_t row = 0; row < rows; row++) {
+            const char* date = date_index + row * kHistoryCacheDateWidth;
+            const char* end = static_cast<const char*>(std::memchr(date, '\0', kHistoryCacheDateWidth));
+            dates.emplace_back(date, end ? static_cast<size_t>(end - date) : kHistoryCacheDateWidth);
+            if (!parseIsoDate(dates.back(), day_numbers[row])) {
+                clear();
+                return false;
+            }
+        }
+
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+            const char* block = base + header.columns_offset + tenor * header.column_stride;
+            columns[tenor].resize(rows);
+            std::memcpy(columns[tenor].data(), block, rows * sizeof(double));
+        }
+        return true;
+    }
+
+    // Best effort: a read-only data directory just means no cache next time
+    bool writeCache(const std::string& cache_file, uint64_t source_size, int64_t source_mtime) const {
+        for (const auto& date : dates) {
+            if (date.size() >= kHistoryCacheDateWidth) return false;
+        }
+
+        size_t rows = dates.size();
+        size_t columns_offset = alignHistoryCache(sizeof(HistoryCacheHeader) + rows * kHistoryCacheDateWidth);
+        size_t column_stride = alignHistoryCache(rows * sizeof(double));
+        std::string image(columns_offset + kHistoryTenorCount * column_stride, '\0');
+
+        char* date_index = &image[sizeof(HistoryCacheHeader)];
+        for (size_t row = 0; row < rows; row++) {
+            std::memcpy(date_index + row * kHistoryCacheDateWidth, dates[row].data(), dates[row].size());
+        }
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+            std::memcpy(&image[columns_offset + tenor * column_stride], columns[tenor].data(),
+                        rows * sizeof(double));
+        }
+
+        HistoryCacheHeader header{};
+        std::memcpy(header.magic, kHistoryCacheMagic, sizeof(header.magic));
+        header.version = kHistoryCacheVersion;
+        header.byte_order = kHistoryCacheByteOrder;
+        header.tenor_count = kHistoryTenorCount;
+        header.date_width = kHistoryCacheDateWidth;
+        header.row_count = rows;
+        header.source_size = source_size;
+        header.source_mtime = source_mtime;
+        header.columns_offset = columns_offset;
+        header.column_stride = column_stride;
+        header.column_layout = column_map.layoutHash();
+        header.payload_checksum = historyCacheChecksum(image.data() + sizeof(header),
+                                                       image.size() - sizeof(header));
+        std::memcpy(&image[0], &header, sizeof(header));
+
+        // Write then rename so readers never map a half-written cache
+        std::string temp_file = cache_file + ".tmp";
+        {
+            std::ofstream out(temp_file, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) return false;
+            out.write(image.data(), static_cast<std::streamsize>(image.size()));
+            if (!out) {
+                out.close();
+                std::remove(temp_file.c_str());
+                return false;
+            }
+        }
+        if (std::rename(temp_file.c_str(), cache_file.c_str()) != 0) {
+            std::remove(temp_file.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Rows parsed from one byte range of the CSV body
+    struct ParsedRows {
+        std::vector<std::string> dates;
+        std::vector<int32_t> day_numbers;
+        std::array<std::vector<double>, kHistoryTenorCount> columns;
+        size_t skipped_rows = 0;
+        size_t no_data_rows = 0;      // holidays: every tenor empty or "ND"
+        size_t missing_values = 0;
+        size_t invalid_values = 0;
+    };
+
+    // Smallest byte range worth handing to another worker
+    static constexpr size_t kParallelParseBytes = 1024 * 1024;
+
+    // Parse whole rows of `body` laid out as `map`; `row_bytes` is a rough
+    // row length for reserving
+    static void parseRows(std::string_view body, size_t row_bytes, const CsvColumnMap& map, ParsedRows& out) {
+        size_t estimated_rows = body.size() / row_bytes + 1;
+        out.dates.reserve(estimated_rows);
+        out.day_numbers.reserve(estimated_rows);
+        for (const auto& column : map.tenors) out.columns[column.tenor].reserve(estimated_rows);
+
+        const double missing = std::numeric_limits<double>::quiet_NaN();
+        CsvStructuralReader reader(body);
+        std::string_view line;
+        CsvFields tokens;
+
+        while (reader.next(line, tokens)) {
+            if (line.empty()) continue;
+
+            int32_t day;
+            if (tokens.size() < map.min_fields || !parseIsoDate(tokens[kCsvDateColumn], day)) {
+                out.skipped_rows++;
+                continue;
+            }
+
+            std::array<double, kHistoryTenorCount> row;
+            size_t row_missing = 0;
+            size_t row_invalid = 0;
+            for (const auto& column : map.tenors) {
+                double& value = row[column.tenor];
+                CsvValueStatus status = parseCsvValue(tokens[column.field], value);
+                if (status == CsvValueStatus::Ok) continue;
+                value = missing;
+                (status == CsvValueStatus::Invalid ? row_invalid : row_missing)++;
+            }
+
+            if (row_missing + row_invalid == map.tenors.size()) {
+                (row_invalid == 0 ? out.no_data_rows : out.skipped_rows)++;
+                continue;
+            }
+            out.missing_values += row_missing;
+            out.invalid_values += row_invalid;
+
+            out.dates.emplace_back(tokens[kCsvDateColumn]);
+            out.day_numbers.push_back(day);
+            for (const auto& column : map.tenors) out.columns[column.tenor].push_back(row[column.tenor]);
+        }
+
+        // Tenors the file has no column for stay aligned with the dates
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+            if (!(map.tenor_mask >> tenor & 1u)) out.columns[tenor].assign(out.dates.size(), missing);
+        }
+    }
+
+    // Append one parsed range; the first one is moved in without copying
+    void appendRows(ParsedRows& rows) {
+        if (dates.empty()) {
+            dates = std::move(rows.dates);
+            day_numbers = std::move(rows.day_numbers);
+            for (size_t i = 0; i < kHistoryTenorCount; i++) columns[i] = std::move(rows.columns[i]);
+            return;
+        }
+        dates.insert(dates.end(), std::make_move_iterator(rows.dates.begin()),
+                     std::make_move_iterator(rows.dates.end()));
+        day_numbers.insert(day_numbers.end(), rows.day_numbers.begin(), rows.day_numbers.end());
+        for (size_t i = 0; i < kHistoryTenorCount; i++) {
+            columns[i].insert(columns[i].end(), rows.columns[i].begin(), rows.columns[i].end());
+        }
+    }
+
+    // Parse `body` (whole lines). With a scheduler a large body is cut into
+    // byte ranges realigned to the next line start and the ranges are parsed
+    // concurrently into their own buffers, returned in file order.
+    static std::vector<ParsedRows> parseBody(std::string_view body, size_t row_bytes, const CsvColumnMap& map,
+                                             TaskScheduler* scheduler) {
+        size_t range_count = 1;
+        if (scheduler) {
+            range_count = std::clamp<size_t>(body.size() / kParallelParseBytes, 1, scheduler->workerCount() * 4);
+        }
+        std::vector<size_t> bounds(range_count + 1, body.size());
+        bounds[0] = 0;
+        for (size_t i = 1; i < range_count; i++) {
+            size_t newline = body.find('\n', std::max(bounds[i - 1], i * (body.size() / range_count)));
+            bounds[i] = newline == std::string_view::npos ? body.size() : newline + 1;
+        }
+
+        std::vector<ParsedRows> ranges(range_count);
+        auto parse = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                parseRows(body.substr(bounds[i], bounds[i + 1] - bounds[i]), row_bytes, map, ranges[i]);
+            }
+        };
+        if (range_count > 1) {
+            scheduler->parallelFor(0, range_count, 1, parse);
+        } else {
+            parse(0, 1);
+        }
+        return ranges;
+    }
+
+    static void reportParseWarnings(const std::string& filename, const std::vector<ParsedRows>& ranges) {
+        size_t skipped_rows = 0;
+        size_t no_data_rows = 0;
+        size_t missing_values = 0;
+        size_t invalid_values = 0;
+        for (const auto& range : ranges) {
+            skipped_rows += range.skipped_rows;
+            no_data_rows += range.no_data_rows;
+            missing_values += range.missing_values;
+            invalid_values += range.invalid_values;
+        }
+
+        if (skipped_rows > 0 || invalid_values > 0) {
+            std::cerr << "Warning: Skipped " << skipped_rows << " malformed rows and "
+                      << invalid_values << " invalid yield values in " << filename << std::endl;
+        }
+        if (no_data_rows > 0 || missing_values > 0) {
+            std::cerr << "Warning: Skipped " << no_data_rows << " dates without data and "
+                      << missing_values << " unpublished yields (empty or ND) in " << filename << std::endl;
+        }
+    }
+
+    // Offset just past the last newline: where a refresh resumes parsing
+    static size_t completeLinesEnd(std::string_view text) {
+        size_t newline = text.rfind('\n');
+        return newline == std::string_view::npos ? 0 : newline + 1;
+    }
+
+    // The complete line ending at `end` (a completeLinesEnd offset), newline
+    // included
+    static std::string_view lineEndingAt(std::string_view text, size_t end) {
+        if (end == 0) return {};
+        size_t newline = end >= 2 ? text.rfind('\n', end - 2) : std::string_view::npos;
+        size_t start = newline == std::string_view::npos ? 0 : newline + 1;
+        return text.substr(start, end - start);
+    }
+
+    // The header of `text` resolved against the tenor mapping; `body_offset`
+    // is where the rows start
+    bool readColumnMap(const std::string& filename, std::string_view text, CsvColumnMap& map,
+                       size_t& body_offset) const {
+        CsvLineReader header_reader(text);
+        std::string_view header;
+        if (!header_reader.next(header)) {
+            std::cerr << "Error: CSV file " << filename << " is empty or unreadable." << std::endl;
+            return false;
+        }
+        body_offset = header_reader.offset();
+        return resolveCsvColumns(filename, header, mapping_file, map);
+    }
+
+    // Text parse of every CSV row into the column store, stitched from the
+    // ranges of parseBody in file order
+    bool parseCSV(const std::string& filename, std::string_view body, size_t row_bytes, const CsvColumnMap& map,
+                  TaskScheduler* scheduler) {
+        clear();
+        column_map = map;
+
+        std::vector<ParsedRows> ranges = parseBody(body, std::max<size_t>(row_bytes, 1), map, scheduler);
+
+        if (ranges.size() > 1) {
+            size_t total_rows = 0;
+            for (const auto& range : ranges) total_rows += range.dates.size();
+            dates.reserve(total_rows);
+            day_numbers.reserve(total_rows);
+            for (auto& column : columns) column.reserve(total_rows);
+        }
+        for (auto& range : ranges) appendRows(range);
+        reportParseWarnings(filename, ranges);
+
+        if (dates.empty()) {
+            std::cerr << "Error: No yield history loaded. Please check the CSV file content." << std::endl;
+            return false;
+        }
+
+        sortByDate();
+        collapseDuplicateDates();
+        return true;
+    }
+
+    // Record where `filename` (mapped as `text`) ends so refreshFromCSV can
+    // pick up from there
+    void rememberSource(const std::string& filename, std::string_view text) {
+        source_file = filename;
+        if (!sourceStamp(filename, source_size_seen, source_mtime_seen)) {
+            source_size_seen = 0;
+            source_mtime_seen = 0;
+        }
+        parsed_offset = completeLinesEnd(text);
+        parsed_tail = lineEndingAt(text, parsed_offset);
+        revision_++;
+    }
+
+    // Merge rows appended to the file. A date already in the history (an
+    // intraday provisional row being superseded) overwrites that row; later
+    // dates are appended. Late rows for earlier dates are collected and
+    // inserted with one sort at the end, however many there are. Returns the
+    // first row that changed.
+    size_t mergeRows(std::vector<ParsedRows>& ranges) {
+        size_t first_changed = size();
+        std::vector<std::pair<ParsedRows*, size_t>> late;
+        for (auto& rows : ranges) {
+            for (size_t i = 0; i < rows.dates.size(); i++) {
+                int32_t day = rows.day_numbers[i];
+                auto it = std::lower_bound(day_numbers.begin(), day_numbers.end(), day);
+                size_t row = static_cast<size_t>(it - day_numbers.begin());
+
+                if (it != day_numbers.end() && *it == day) {
+                    for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+                        columns[tenor][row] = rows.columns[tenor][i];
+                    }
+                    first_changed = std::min(first_changed, row);
+                } else if (it == day_numbers.end()) {
+                    appendRow(rows, i);
+                } else {
+                    late.emplace_back(&rows, i);
+                }
+            }
+        }
+        if (late.empty()) return first_changed;
+
+        // Rare: late rows, possibly repeating a date. The last one for a date wins.
+        auto day_of = [](const std::pair<ParsedRows*, size_t>& entry) { return entry.first->day_numbers[entry.second]; };
+        std::stable_sort(late.begin(), late.end(), [&](const auto& a, const auto& b) { return day_of(a) < day_of(b); });
+        for (size_t k = 0; k < late.size(); k++) {
+            if (k + 1 < late.size() && day_of(late[k + 1]) == day_of(late[k])) continue;
+            appendRow(*late[k].first, late[k].second);
+        }
+        sortByDate();
+        auto first_late = std::lower_bound(day_numbers.begin(), day_numbers.end(), day_of(late.front()));
+        return std::min(first_changed, static_cast<size_t>(first_late - day_numbers.begin()));
+    }
+
+    void appendRow(ParsedRows& rows, size_t i) {
+        dates.push_back(std::move(rows.dates[i]));
+        day_numbers.push_back(rows.day_numbers[i]);
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) columns[tenor].push_back(rows.columns[tenor][i]);
+    }
+
+public:
+    CurveHistory() = default;
+
+    // Load the whole history, using the binary snapshot next to the CSV when
+    // it was built from the same file revision and header layout, and
+    // rebuilding it otherwise. Columns are found by header label (see
+    // CsvColumnMap). A text parse runs on `scheduler` when one is given.
+    bool loadFromCSV(const std::string& filename, TaskScheduler* scheduler = nullptr) {
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+
+        CsvColumnMap map;
+        size_t body_offset;
+        if (!readColumnMap(filename, file.view(), map, body_offset)) return false;
+
+        uint64_t source_size = 0;
+        int64_t source_mtime = 0;
+        bool have_stamp = cache_enabled && sourceStamp(filename, source_size, source_mtime);
+        std::string cache_file = filename + ".ycache";
+
+        if (have_stamp && loadCache(cache_file, source_size, source_mtime, map.layoutHash())) {
+            column_map = map;
+            rememberSource(filename, file.view());
+            return true;
+        }
+
+        if (!parseCSV(filename, file.view().substr(body_offset), body_offset, map, scheduler)) return false;
+
+        if (have_stamp) writeCache(cache_file, source_size, source_mtime);
+        rememberSource(filename, file.view());
+        return true;
+    }
+
+    // Tail-follow: parse only the complete lines appended to `filename`
+    // since the last load or refresh. An unchanged size and mtime cost one
+    // stat; a file that shrank, was replaced or was never loaded is reloaded
+    // in full, and a reload that fails leaves the history as it was.
+    // `first_changed` is the first row that changed (size() when none did,
+    // 0 after a full reload). The snapshot cache is left alone: it no longer
+    // matches the file and is rebuilt by the next full load.
+    bool refreshFromCSV(const std::string& filename, size_t& first_changed, TaskScheduler* scheduler = nullptr) {
+        first_changed = size();
+
+        uint64_t source_size = 0;
+        int64_t source_mtime = 0;
+        if (!sourceStamp(filename, source_size, source_mtime)) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+        bool same_file = !empty() && filename == source_file;
+        if (same_file && source_size == source_size_seen && source_mtime == source_mtime_seen) return true;
+
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+        std::string_view text = file.view();
+
+        // An append leaves everything up to parsed_offset in place; checking
+        // the last line parsed there catches rewrites and rows added on top
+        bool appended_only = same_file && parsed_offset >= parsed_tail.size() && parsed_offset <= text.size() &&
+                             text.substr(parsed_offset - parsed_tail.size(), parsed_tail.size()) == parsed_tail;
+        if (!appended_only) {
+            // Load into a fresh history so a half-written file keeps the
+            // rows we have
+            CurveHistory reloaded;
+            reloaded.cache_enabled = cache_enabled;
+            reloaded.mapping_file = mapping_file;
+            if (!reloaded.loadFromCSV(filename, scheduler)) return false;
+            reloaded.revision_ = revision_ + 1;
+            *this = std::move(reloaded);
+            first_changed = 0;
+            return true;
+        }
+
+        size_t end = completeLinesEnd(text);
+        std::string_view appended = text.substr(parsed_offset, end > parsed_offset ? end - parsed_offset : 0);
+        std::vector<ParsedRows> ranges = parseBody(appended, 128, column_map, scheduler);
+        first_changed = mergeRows(ranges);
+        reportParseWarnings(filename, ranges);
+
+        if (end > parsed_offset) {
+            parsed_offset = end;
+            parsed_tail = lineEndingAt(text, end);
+        }
+        source_size_seen = source_size;
+        source_mtime_seen = source_mtime;
+        if (first_changed < size()) revision_++;
+        return true;
+    }
+
+    // Bumped by every load and by every refresh that changed a row
+    uint64_t revision() const { return revision_; }
+
+    void setCacheEnabled(bool enabled) { cache_enabled = enabled; }
+
+    // Label -> maturity file used to resolve CSV headers; empty (the
+    // default) looks for maturity_mapping_live.json next to the CSV
+    void setTenorMappingFile(const std::string& filename) { mapping_file = filename; }
+
+    // True when the loaded file has a column for `tenor`; the others are all NaN
+    bool hasTenor(size_t tenor) const { return tenor < kHistoryTenorCount && (column_map.tenor_mask >> tenor & 1u); }
+
+    size_t size() const { return dates.size(); }
+    bool empty() const { return dates.empty(); }
+
+    const std::string& getDate(size_t row) const { return dates[row]; }
+    const std::vector<std::string>& getDates() const { return dates; }
+
+    // Yield in percent, NaN when the tenor was not published that day
+    double getYield(size_t row, size_t tenor) const { return columns[tenor][row]; }
+    const std::vector<double>& getColumn(size_t tenor) const { return columns[tenor]; }
+
+    const std::vector<int32_t>& getDayNumbers() const { return day_numbers; }
+    int32_t getDayNumber(size_t row) const { return day_numbers[row]; }
+
+    size_t latestRow() const { return dates.size() - 1; }
+
+    // Row published exactly on `day`, or size() if there is none
+    size_t findExact(int32_t day) const {
+        auto it = std::lower_bound(day_numbers.begin(), day_numbers.end(), day);
+        if (it == day_numbers.end() || *it != day) return size();
+        return static_cast<size_t>(it - day_numbers.begin());
+    }
+
+    // Latest row on or before `day` (the curve "as of" that date), or size()
+    // if the history starts later
+    size_t findNearestPrior(int32_t day) const {
+        auto it = std::upper_bound(day_numbers.begin(), day_numbers.end(), day);
+        if (it == day_numbers.begin()) return size();
+        return static_cast<size_t>(it - day_numbers.begin()) - 1;
+    }
+
+    // Rows [first, second) whose dates fall inside `range`
+    std::pair<size_t, size_t> findRange(const DateRange& range) const {
+        auto begin = std::lower_bound(day_numbers.begin(), day_numbers.end(), range.first);
+        auto end = std::upper_bound(begin, day_numbers.end(), range.last);
+        return {static_cast<size_t>(begin - day_numbers.begin()),
+                static_cast<size_t>(end - day_numbers.begin())};
+    }
+
+    // First row matching a date query ("2024-03-15", "2024-03", "2024-Q3",
+    // ...), or size() if the query is invalid or matches nothing
+    size_t findDate(std::string_view query) const {
+        DateRange range;
+        if (!parseDateQuery(query, range)) return size();
+        auto rows = findRange(range);
+        return rows.first < rows.second ? rows.first : size();
+    }
+};
+
+#endif // CURVE_HISTORY_H
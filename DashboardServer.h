@@ -0,0 +1,666 @@
+#ifndef DASHBOARD_SERVER_H
+#define DASHBOARD_SERVER_H
+
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CurveHistory.h"
+#include "HistoryExport.h"
+#include "JsonWriter.h"
+#include "TreasuryCsv.h"
+#include "TreasuryDates.h"
+#include "YieldCurveLive.h"
+
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Embedded HTTP/1.1 server for the docs/ dashboard. Static files are served
+// from the docs directory; three endpoints render JSON straight from the
+// in-memory history:
+//
+//   GET /curve[?date=D]                 dashboard document for one curve
+//                                       (same as exportToJSON), latest by default
+//   GET /history[?date=Q][&format=F]    yields per tenor as columnar arrays
+//                                       (F=columns) or one line per curve
+//                                       (F=ndjson), every curve by default
+//   GET /forwards[?date=D][&grid=a,b,..] forward matrix on a maturity grid,
+//                                       the file's tenors by default
+//
+// D is YYYY-MM-DD (the curve in force that day) or "latest", Q any date query
+// accepted by the batch commands. Every JSON response carries an ETag derived
+// from the rows it covers and the history version: a matching If-None-Match
+// is answered 304 without rendering anything, and rendered bodies are kept
+// so another client asking for the same rows gets them without
+// re-serializing.
+//
+// Connections are served from one poll() loop with non-blocking sockets and
+// per-client output buffers, like CurveQueryServer; keep-alive and pipelined
+// requests are supported, request bodies are not.
+class DashboardHttpServer {
+private:
+    struct CachedBody {
+        std::string etag;
+        std::string body;
+    };
+
+    struct Response {
+        int status = 200;
+        const char* content_type = "application/json";
+        std::string etag;
+        const std::string* body = nullptr;   // points into the cache or `owned`
+        std::string owned;
+    };
+
+    const CurveHistory& history;
+    InterpolationMode interpolation;
+    std::string docs_dir;
+    std::unordered_map<std::string, CachedBody> cache;
+    size_t cache_bytes = 0;
+    mutable std::vector<char> json_scratch;   // lent to every JsonWriter a render uses; renders run on one thread
+    std::atomic<bool> running{false};
+    int listen_fd = -1;
+    std::function<void()> idle_task;
+
+    static constexpr size_t kMaxRequestHead = 8192;
+    static constexpr size_t kMaxOutbox = 8 * 1024 * 1024;   // stop reading a client that does not read responses
+    static constexpr size_t kMaxCacheBytes = 64 * 1024 * 1024;
+    static constexpr int kPollIntervalMs = 200;   // how quickly stop() is noticed
+#if defined(MSG_NOSIGNAL)
+    static constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+    static constexpr int kSendFlags = 0;
+#endif
+
+    static uint64_t hashBytes(std::string_view text, uint64_t hash = 0xcbf29ce484222325ULL) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    // Identifies the loaded data: changes whenever curves are added or
+    // refreshed or the interpolation differs, which invalidates every cached
+    // body
+    std::string historyVersion() const {
+        std::string version = std::to_string(history.revision()) + ":" + std::to_string(history.size());
+        if (!history.empty()) version += "@" + std::to_string(history.getDayNumber(history.latestRow()));
+        version += interpolation == InterpolationMode::CubicSpline ? "s" : "l";
+        return version;
+    }
+
+    static std::string makeETag(std::string_view key, std::string_view version) {
+        char etag[24];
+        std::snprintf(etag, sizeof(etag), "\"%016llx\"",
+                      static_cast<unsigned long long>(hashBytes(version, hashBytes(key))));
+        return etag;
+    }
+
+    static int hexDigit(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // Value of `name` in a query string, with %XX and '+' decoded
+    static bool queryParam(std::string_view query, std::string_view name, std::string& value) {
+        size_t pos = 0;
+        while (pos < query.size()) {
+            size_t end = query.find('&', pos);
+            if (end == std::string_view::npos) end = query.size();
+            std::string_view pair = query.substr(pos, end - pos);
+            pos = end + 1;
+
+            size_t equals = pair.find('=');
+            if (pair.substr(0, equals) != name) continue;
+
+            std::string_view raw = equals == std::string_view::npos ? std::string_view() : pair.substr(equals + 1);
+            value.clear();
+            for (size_t i = 0; i < raw.size(); i++) {
+                if (raw[i] == '+') {
+                    value += ' ';
+                } else if (raw[i] == '%' && i + 2 < raw.size() && hexDigit(raw[i + 1]) >= 0 &&
+                           hexDigit(raw[i + 2]) >= 0) {
+                    value += static_cast<char>(hexDigit(raw[i + 1]) * 16 + hexDigit(raw[i + 2]));
+                    i += 2;
+                } else {
+                    value += raw[i];
+                }
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // Single curve row for `date` ("latest" or empty = latest, otherwise the
+    // curve in force that day)
+    bool resolveRow(const std::string& date, size_t& row, std::string& error) const {
+        if (history.empty()) {
+            error = "no data loaded";
+            return false;
+        }
+        if (date.empty() || date == "latest") {
+            row = history.latestRow();
+            return true;
+        }
+        int32_t day;
+        if (!parseIsoDate(date, day)) {
+            error = "invalid date";
+            return false;
+        }
+        row = history.findNearestPrior(day);
+        if (row >= history.size()) {
+            error = "no curve on or before date";
+            return false;
+        }
+        return true;
+    }
+
+    static void errorBody(Response& response, int status, const std::string& message) {
+        response.status = status;
+        response.owned = "{\"error\": \"" + message + "\"}\n";
+        response.body = &response.owned;
+    }
+
+    // Serve `key` from the cache, rendering it with `render` only when the
+    // cached body is missing or stale
+    template <class Render>
+    void cachedJson(const std::string& key, const std::string& if_none_match, Response& response, Render render) {
+        response.etag = makeETag(key, historyVersion());
+        if (if_none_match == response.etag) {
+            response.status = 304;
+            return;
+        }
+
+        auto it = cache.find(key);
+        if (it == cache.end() || it->second.etag != response.etag) {
+            std::string body;
+            render(body);
+            if (it != cache.end()) {
+                cache_bytes -= it->second.body.size();
+                cache.erase(it);
+            }
+            if (cache_bytes + body.size() > kMaxCacheBytes) {
+                cache.clear();
+                cache_bytes = 0;
+            }
+            cache_bytes += body.size();
+            CachedBody& entry = cache[key];
+            entry.etag = response.etag;
+            entry.body = std::move(body);
+            response.body = &entry.body;
+        } else {
+            response.body = &it->second.body;
+        }
+    }
+
+    void renderCurve(size_t row, std::string& body) const {
+        YieldCurveLive curve;
+        curve.setInterpolationMode(interpolation);
+        curve.loadFromHistory(history, row);
+        JsonWriter json(body, json_scratch);
+        curve.writeJSON(json);
+    }
+
+    void renderHistory(std::pair<size_t, size_t> rows, HistoryJsonFormat format, std::string& body) const {
+        JsonWriter json(body, json_scratch);
+        writeHistoryJSON(json, history, rows, format);
+    }
+
+    void renderForwards(size_t row, const std::vector<double>& grid, std::string& body) const {
+        YieldCurveLive curve;
+        curve.setInterpolationMode(interpolation);
+        curve.loadFromHistory(history, row);
+        ForwardMatrix matrix = curve.forwardMatrix(grid);
+
+        JsonWriter json(body, json_scratch);
+        json.beginObject();
+        json.key("date").string(history.getDate(row));
+        json.key("grid").beginArray(true);
+        for (double maturity : matrix.grid) json.number(maturity);
+        json.endArray();
+
+        // Row i holds the forwards from grid[i] to each later grid point
+        json.key("forwards").beginArray();
+        for (size_t i = 0; i + 1 < matrix.size(); i++) {
+            const double* rates = matrix.row(i);
+            json.beginArray(true);
+            for (size_t k = 0; k < matrix.rowLength(i); k++) json.number(rates[k]);
+            json.endArray();
+        }
+        json.endArray();
+        json.endObject();
+        json.raw("\n");
+    }
+
+    void handleApi(std::string_view path, std::string_view query, const std::string& if_none_match,
+                   Response& response) {
+        std::string date;
+        queryParam(query, "date", date);
+        std::string error;
+
+        if (path == "/curve") {
+            size_t row;
+            if (!resolveRow(date, row, error)) return errorBody(response, 404, error);
+            cachedJson("curve:" + std::to_string(row), if_none_match, response,
+                       [&](std::string& body) { renderCurve(row, body); });
+            return;
+        }
+
+        if (path == "/history") {
+            std::pair<size_t, size_t> rows{0, history.size()};
+            if (!date.empty()) {
+                DateRange range;
+                if (!parseDateQuery(date, range)) return errorBody(response, 400, "invalid date query");
+                rows = history.findRange(range);
+            }
+            if (rows.first >= rows.second) return errorBody(response, 404, "no curves in range");
+
+            std::string format_name;
+            queryParam(query, "format", format_name);
+            HistoryJsonFormat format = HistoryJsonFormat::Columns;
+            if (format_name == "ndjson") {
+                format = HistoryJsonFormat::NDJSON;
+                response.content_type = "application/x-ndjson";
+            } else if (!format_name.empty() && format_name != "columns") {
+                return errorBody(response, 400, "format must be columns or ndjson");
+            }
+            cachedJson(std::string(format == HistoryJsonFormat::NDJSON ? "ndjson:" : "history:") + std::to_string(rows.first) + "-" + std::to_string(rows.second),
+                       if_none_match, response, [&](std::string& body) { renderHistory(rows, format, body); });
+            return;
+        }
+
+        // /forwards
+        size_t row;
+        if (!resolveRow(date, row, error)) return errorBody(response, 404, error);
+
+        std::vector<double> grid;
+        for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+            if (history.hasTenor(tenor)) grid.push_back(kHistoryTenorYears[tenor]);
+        }
+        std::string grid_text;
+        if (queryParam(query, "grid", grid_text)) {
+            grid.clear();
+            std::string_view rest = grid_text;
+            while (!rest.empty()) {
+                size_t comma = rest.find(',');
+                double maturity;
+                if (!parseCsvDouble(rest.substr(0, comma), maturity) || maturity <= 0.0 || maturity > 100.0) {
+                    return errorBody(response, 400, "invalid grid");
+                }
+                grid.push_back(maturity);
+                rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+            }
+            if (grid.size() < 2 || grid.size() > 1024) return errorBody(response, 400, "grid needs 2 to 1024 maturities");
+        }
+        cachedJson("forwards:" + std::to_string(row) + ":" + grid_text, if_none_match, response,
+                   [&](std::string& body) { renderForwards(row, grid, body); });
+    }
+
+    static const char* contentType(std::string_view path) {
+        size_t dot = path.rfind('.');
+        std::string_view ext = dot == std::string_view::npos ? std::string_view() : path.substr(dot + 1);
+        if (ext == "html") return "text/html; charset=utf-8";
+        if (ext == "js") return "text/javascript; charset=utf-8";
+        if (ext == "css") return "text/css; charset=utf-8";
+        if (ext == "json") return "application/json";
+        if (ext == "svg") return "image/svg+xml";
+        if (ext == "png") return "image/png";
+        if (ext == "ico") return "image/x-icon";
+        return "application/octet-stream";
+    }
+
+#if !defined(_WIN32)
+    void handleStatic(std::string_view path, const std::string& if_none_match, Response& response) {
+        if (path == "/") path = "/index.html";
+        if (path.find("..") != std::string_view::npos || path.find('\\') != std::string_view::npos) {
+            return errorBody(response, 404, "not found");
+        }
+
+        std::string filename = docs_dir + std::string(path);
+        struct stat info;
+        if (::stat(filename.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) return errorBody(response, 404, "not found");
+
+        response.etag = makeETag(filename, std::to_string(info.st_size) + ":" + std::to_string(info.st_mtime));
+        response.content_type = contentType(path);
+        if (if_none_match == response.etag) {
+            response.status = 304;
+            return;
+        }
+
+        std::ifstream file(filename, std::ios::binary);
+        response.owned.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (!file) return errorBody(response, 500, "read failed");
+        response.body = &response.owned;
+    }
+#endif
+
+    static const char* statusText(int status) {
+        switch (status) {
+            case 200: return "OK";
+            case 304: return "Not Modified";
+            case 400: return "Bad Request";
+            case 404: return "Not Found";
+            case 405: return "Method Not Allowed";
+            case 431: return "Request Header Fields Too Large";
+            default: return "Internal Server Error";
+        }
+    }
+
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); i++) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void writeResponse(const Response& response, bool keep_alive, bool head_only, std::string& out) {
+        size_t length = response.body ? response.body->size() : 0;
+        out += "HTTP/1.1 ";
+        out += std::to_string(response.status);
+        out += ' ';
+        out += statusText(response.status);
+        out += "\r\nServer: yield_analyzer_live\r\n";
+        if (response.status != 304) {
+            out += "Content-Type: ";
+            out += response.content_type;
+            out += "\r\nContent-Length: ";
+            out += std::to_string(length);
+            out += "\r\n";
+        }
+        if (response.status == 405) out += "Allow: GET, HEAD\r\n";
+        if (!response.etag.empty()) {
+            out += "ETag: ";
+            out += response.etag;
+            out += "\r\nCache-Control: no-cache\r\n";
+        }
+        out += keep_alive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+        if (!head_only && response.status != 304 && response.body) out += *response.body;
+    }
+
+public:
+    DashboardHttpServer(const CurveHistory& source, std::string docs_directory,
+                        InterpolationMode mode = InterpolationMode::Linear)
+        : history(source), interpolation(mode), docs_dir(std::move(docs_directory)) {}
+
+    ~DashboardHttpServer() { close(); }
+
+    DashboardHttpServer(const DashboardHttpServer&) = delete;
+    DashboardHttpServer& operator=(const DashboardHttpServer&) = delete;
+
+    // Run `task` on the server thread between poll rounds, at least every
+    // kPollIntervalMs; it may refresh the history (see historyVersion)
+    void setIdleTask(std::function<void()> task) { idle_task = std::move(task); }
+
+    // Answer one complete request head (request line and headers, without
+    // the blank line) by appending the full response to `out`. Returns false
+    // when the connection should close after this response.
+    bool handleRequest(std::string_view head, std::string& out) {
+        size_t line_end = head.find("\r\n");
+        std::string_view request_line = head.substr(0, line_end);
+        std::string_view headers = line_end == std::string_view::npos ? std::string_view() : head.substr(line_end + 2);
+
+        size_t first_space = request_line.find(' ');
+        size_t second_space = request_line.rfind(' ');
+        Response response;
+        bool keep_alive = false;
+        bool head_only = false;
+
+        if (first_space == std::string_view::npos || second_space <= first_space) {
+            errorBody(response, 400, "malformed request line");
+        } else {
+            std::string_view method = request_line.substr(0, first_space);
+            std::string_view target = request_line.substr(first_space + 1, second_space - first_space - 1);
+            std::string_view version = request_line.substr(second_space + 1);
+            keep_alive = version == "HTTP/1.1";
+            head_only = method == "HEAD";
+
+            std::string if_none_match;
+            bool has_body = false;
+            while (!headers.empty()) {
+                size_t end = headers.find("\r\n");
+                std::string_view header = headers.substr(0, end);
+                headers = end == std::string_view::npos ? std::string_view() : headers.substr(end + 2);
+
+                size_t colon = header.find(':');
+                if (colon == std::string_view::npos) continue;
+                std::string_view name = header.substr(0, colon);
+                std::string_view value = header.substr(colon + 1);
+                while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+                while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+
+                if (equalsIgnoreCase(name, "If-None-Match")) {
+                    if_none_match = value;
+                } else if (equalsIgnoreCase(name, "Connection")) {
+                    if (equalsIgnoreCase(value, "close")) keep_alive = false;
+                    if (equalsIgnoreCase(value, "keep-alive")) keep_alive = true;
+                } else if (equalsIgnoreCase(name, "Content-Length") && value != "0") {
+                    has_body = true;
+                } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+                    has_body = true;
+                }
+            }
+
+            size_t question = target.find('?');
+            std::string_view path = target.substr(0, question);
+            std::string_view query = question == std::string_view::npos ? std::string_view() : target.substr(question + 1);
+
+            if (method != "GET" && method != "HEAD") {
+                errorBody(response, 405, "only GET and HEAD are supported");
+                keep_alive = false;
+            } else if (has_body) {
+                errorBody(response, 400, "request bodies are not supported");
+                keep_alive = false;
+            } else if (path == "/curve" || path == "/history" || path == "/forwards") {
+                handleApi(path, query, if_none_match, response);
+            } else {
+#if !defined(_WIN32)
+                handleStatic(path, if_none_match, response);
+#else
+                errorBody(response, 404, "not found");
+#endif
+            }
+        }
+
+        writeResponse(response, keep_alive, head_only, out);
+        return keep_alive;
+    }
+
+    size_t cachedBodies() const { return cache.size(); }
+
+#if !defined(_WIN32)
+    // Listen on `address`:`port` (IPv4, e.g. "127.0.0.1")
+    bool listen(const std::string& address, int port) {
+        close();
+
+        sockaddr_in socket_address{};
+        socket_address.sin_family = AF_INET;
+        socket_address.sin_port = htons(static_cast<uint16_t>(port));
+        if (port <= 0 || port > 65535 || ::inet_pton(AF_INET, address.c_str(), &socket_address.sin_addr) != 1) {
+            std::cerr << "Error: Invalid listen address " << address << ":" << port << std::endl;
+            return false;
+        }
+
+        listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            std::cerr << "Error: Could not create socket: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        int reuse = 1;
+        ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&socket_address), sizeof(socket_address)) != 0 ||
+            ::listen(listen_fd, 64) != 0) {
+            std::cerr << "Error: Could not listen on " << address << ":" << port << ": " << std::strerror(errno)
+                      << std::endl;
+            ::close(listen_fd);
+            listen_fd = -1;
+            return false;
+        }
+
+        ::fcntl(listen_fd, F_SETFL, ::fcntl(listen_fd, F_GETFL, 0) | O_NONBLOCK);
+        return true;
+    }
+
+    // Port actually bound (useful after listening on port 0)
+    int port() const {
+        sockaddr_in address{};
+        socklen_t length = sizeof(address);
+        if (listen_fd < 0 || ::getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) return 0;
+        return ntohs(address.sin_port);
+    }
+
+    // Serve clients until stop() is called. A client whose unsent responses
+    // pass kMaxOutbox is not read (nor its pipelined requests answered)
+    // until the outbox drains.
+    void run() {
+        if (listen_fd < 0) return;
+        running.store(true);
+
+        struct Client {
+            int fd;
+            std::string pending;    // request bytes not yet answered
+            std::string outbox;     // response bytes not yet sent
+            size_t sent = 0;
+            bool closing = false;   // close once the outbox drains
+        };
+        std::vector<Client> clients;
+        std::vector<pollfd> fds;
+        char buffer[16384];
+
+        auto has_room = [](const Client& client) { return client.outbox.size() - client.sent < kMaxOutbox; };
+
+        while (running.load(std::memory_order_relaxed)) {
+            if (idle_task) idle_task();
+
+            fds.clear();
+            fds.push_back(pollfd{listen_fd, POLLIN, 0});
+            for (const auto& client : clients) {
+                short events = client.closing || !has_room(client) ? 0 : POLLIN;
+                if (client.sent < client.outbox.size()) events |= POLLOUT;
+                fds.push_back(pollfd{client.fd, events, 0});
+            }
+
+            int ready = ::poll(fds.data(), fds.size(), kPollIntervalMs);
+            if (ready <= 0) continue;
+
+            // Serve existing clients before accepting, so indices line up with fds
+            for (size_t i = clients.size(); i-- > 0;) {
+                short events = fds[i + 1].revents;
+                if (events == 0) continue;
+
+                Client& client = clients[i];
+                bool keep = (events & (POLLERR | POLLNVAL)) == 0;
+
+                if (keep && (events & (POLLIN | POLLHUP)) && !client.closing && has_room(client)) {
+                    ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+                    if (received > 0) {
+                        client.pending.append(buffer, static_cast<size_t>(received));
+                    } else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        keep = false;
+                    }
+                }
+
+                while (keep) {
+                    // Answer complete request heads in arrival order while the outbox has room
+                    size_t start = 0;
+                    while (!client.closing && has_room(client)) {
+                        size_t end = client.pending.find("\r\n\r\n", start);
+                        if (end == std::string::npos) break;
+                        std::string_view head(client.pending.data() + start, end - start);
+                        client.closing = !handleRequest(head, client.outbox);
+                        start = end + 4;
+                    }
+                    client.pending.erase(0, start);
+                    if (!client.closing && client.pending.size() > kMaxRequestHead &&
+                        client.pending.find("\r\n\r\n") == std::string::npos) {
+                        Response too_large;
+                        errorBody(too_large, 431, "request head too large");
+                        writeResponse(too_large, false, false, client.outbox);
+                        client.closing = true;
+                    }
+
+                    // Send as much as the socket takes; the rest waits for POLLOUT
+                    while (client.sent < client.outbox.size()) {
+                        ssize_t n = ::send(client.fd, client.outbox.data() + client.sent,
+                                           client.outbox.size() - client.sent, kSendFlags);
+                        if (n > 0) {
+                            client.sent += static_cast<size_t>(n);
+                        } else {
+                            keep = n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+                            break;
+                        }
+                    }
+                    if (client.sent < client.outbox.size()) break;
+
+                    client.outbox.clear();
+                    client.sent = 0;
+                    if (client.closing) keep = false;
+                    // Drained: heads held back while the outbox was full can go now
+                    if (client.pending.find("\r\n\r\n") == std::string::npos) break;
+                }
+
+                if (!keep) {
+                    ::close(client.fd);
+                    clients.erase(clients.begin() + static_cast<std::ptrdiff_t>(i));
+                }
+            }
+
+            if (fds[0].revents & POLLIN) {
+                int fd;
+                while ((fd = ::accept(listen_fd, nullptr, nullptr)) >= 0) {
+                    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+                    clients.push_back(Client{fd, {}, {}, 0, false});
+                }
+            }
+        }
+
+        for (const auto& client : clients) ::close(client.fd);
+    }
+
+    // Safe to call from another thread or a signal handler
+    void stop() { running.store(false); }
+
+    void close() {
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+            listen_fd = -1;
+        }
+    }
+#else
+    bool listen(const std::string&, int) {
+        std::cerr << "Error: Dashboard server mode is not available on this platform" << std::endl;
+        return false;
+    }
+    int port() const { return 0; }
+    void run() {}
+    void stop() {}
+    void close() {}
+#endif
+};
+
+#endif // DASHBOARD_SERVER_H
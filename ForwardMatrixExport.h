@@ -0,0 +1,211 @@
+#ifndef FORWARD_MATRIX_EXPORT_H
+#define FORWARD_MATRIX_EXPORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CurveHistory.h"
+#include "TaskScheduler.h"
+#include "YieldCurveLive.h"
+
+// Streams one forward matrix per historical curve to disk. Only the matrices
+// being built are held in memory (one ~500 KB buffer per worker for a monthly
+// 30Y grid), regardless of how many dates are written.
+//
+// Binary layout: header, the grid as `grid_size` doubles, then one record per
+// curve: int32 day number, 4 bytes padding, and the packed upper triangle in
+// ForwardMatrix row order (`grid_size * (grid_size - 1) / 2` doubles).
+//
+// CSV layout: "date,start,end,forward", one line per start < end pair.
+enum class ForwardExportFormat {
+    Binary,
+    CSV
+};
+
+inline constexpr char kForwardMatrixMagic[8] = {'Y', 'C', 'F', 'W', 'D', '\0', '\0', '\0'};
+inline constexpr uint32_t kForwardMatrixVersion = 1;
+inline constexpr uint32_t kForwardMatrixByteOrder = 0x01020304;
+
+struct ForwardMatrixFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t grid_size;
+    uint64_t curve_count;
+    uint64_t record_size;
+};
+
+class ForwardMatrixWriter {
+private:
+    std::ofstream out;
+    ForwardExportFormat format = ForwardExportFormat::Binary;
+    std::vector<double> grid;
+    std::vector<std::string> grid_labels;   // CSV: maturities formatted once
+    std::string buffer;
+    uint64_t curve_count = 0;
+
+    uint64_t recordSize() const {
+        size_t n = grid.size();
+        return 8 + (n > 1 ? n * (n - 1) / 2 : 0) * sizeof(double);
+    }
+
+    void writeHeader() {
+        ForwardMatrixFileHeader header{};
+        std::memcpy(header.magic, kForwardMatrixMagic, sizeof(header.magic));
+        header.version = kForwardMatrixVersion;
+        header.byte_order = kForwardMatrixByteOrder;
+        header.grid_size = grid.size();
+        header.curve_count = curve_count;
+        header.record_size = recordSize();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+public:
+    ForwardMatrixWriter() = default;
+    ~ForwardMatrixWriter() { close(); }
+
+    ForwardMatrixWriter(const ForwardMatrixWriter&) = delete;
+    ForwardMatrixWriter& operator=(const ForwardMatrixWriter&) = delete;
+
+    // `matrix_grid` must be the sorted, de-duplicated grid the matrices are
+    // built on (ForwardMatrix::grid)
+    bool open(const std::string& filename, const std::vector<double>& matrix_grid, ForwardExportFormat fmt) {
+        close();
+        format = fmt;
+        grid = matrix_grid;
+        curve_count = 0;
+
+        out.open(filename, fmt == ForwardExportFormat::Binary ? std::ios::binary | std::ios::trunc : std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Error: Could not create file " << filename << std::endl;
+            return false;
+        }
+
+        if (format == ForwardExportFormat::Binary) {
+            writeHeader();
+            out.write(reinterpret_cast<const char*>(grid.data()),
+                      static_cast<std::streamsize>(grid.size() * sizeof(double)));
+        } else {
+            grid_labels.resize(grid.size());
+            char label[32];
+            for (size_t i = 0; i < grid.size(); i++) {
+                int length = std::snprintf(label, sizeof(label), "%.6f", grid[i]);
+                grid_labels[i].assign(label, static_cast<size_t>(length));
+            }
+            out << "date,start,end,forward\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    bool write(int32_t day, const ForwardMatrix& matrix) {
+        if (!out.is_open() || matrix.grid != grid) return false;
+
+        size_t n = grid.size();
+        if (format == ForwardExportFormat::Binary) {
+            char prefix[8] = {};
+            std::memcpy(prefix, &day, sizeof(day));
+            out.write(prefix, sizeof(prefix));
+            out.write(reinterpret_cast<const char*>(matrix.rates.data()),
+                      static_cast<std::streamsize>(matrix.rates.size() * sizeof(double)));
+        } else {
+            // Format a whole row into one buffer, then hand it to the stream
+            std::string date = formatIsoDate(day);
+            char rate[32];
+            for (size_t i = 0; i + 1 < n; i++) {
+                buffer.clear();
+                const double* row = matrix.row(i);
+                for (size_t j = i + 1; j < n; j++) {
+                    int length = std::snprintf(rate, sizeof(rate), "%.6f", row[j - i - 1]);
+                    buffer += date;
+                    buffer += ',';
+                    buffer += grid_labels[i];
+                    buffer += ',';
+                    buffer += grid_labels[j];
+                    buffer += ',';
+                    buffer.append(rate, static_cast<size_t>(length));
+                    buffer += '\n';
+                }
+                out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            }
+        }
+
+        if (!out) return false;
+        curve_count++;
+        return true;
+    }
+
+    // Patches the final curve count into the binary header
+    bool close() {
+        if (!out.is_open()) return true;
+        if (format == ForwardExportFormat::Binary) {
+            out.seekp(0);
+            writeHeader();
+        }
+        bool ok = static_cast<bool>(out);
+        out.close();
+        return ok;
+    }
+
+    uint64_t curvesWritten() const { return curve_count; }
+};
+
+// Forward matrices for history rows [rows.first, rows.second). With a
+// scheduler, matrices are built one batch (a curve per worker) at a time in
+// parallel and then written in date order, so memory stays at one matrix
+// per worker. Returns the number of curves written, or 0 on error.
+inline size_t exportForwardMatrices(const CurveHistory& history, std::pair<size_t, size_t> rows,
+                                    const std::vector<double>& grid, const std::string& filename,
+                                    ForwardExportFormat format,
+                                    InterpolationMode mode = InterpolationMode::Linear,
+                                    TaskScheduler* scheduler = nullptr) {
+    rows.second = std::min(rows.second, history.size());
+    if (rows.first >= rows.second) {
+        std::cerr << "Warning: No curves in range, " << filename << " not written" << std::endl;
+        return 0;
+    }
+
+    size_t batch_size = scheduler ? scheduler->workerCount() : 1;
+    std::vector<ForwardMatrix> batch(batch_size);
+    std::vector<YieldCurveLive> curves(batch_size);
+    for (auto& curve : curves) curve.setInterpolationMode(mode);
+
+    ForwardMatrixWriter writer;
+    bool opened = false;
+
+    for (size_t first = rows.first; first < rows.second; first += batch_size) {
+        size_t count = std::min(batch_size, rows.second - first);
+        auto build = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                curves[i].loadFromHistory(history, first + i);
+                curves[i].forwardMatrix(grid, batch[i]);
+            }
+        };
+        if (scheduler) {
+            scheduler->parallelFor(0, count, 1, build);
+        } else {
+            build(0, count);
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            if (!opened) {
+                if (!writer.open(filename, batch[i].grid, format)) return 0;
+                opened = true;
+            }
+            if (!writer.write(history.getDayNumber(first + i), batch[i])) {
+                std::cerr << "Error: Failed writing forward matrix to " << filename << std::endl;
+                return 0;
+            }
+        }
+    }
+
+    return writer.close() ? writer.curvesWritten() : 0;
+}
+
+#endif // FORWARD_MATRIX_EXPORT_H
@@ -0,0 +1,187 @@
+#ifndef HISTORY_ANALYTICS_H
+#define HISTORY_ANALYTICS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CurveHistory.h"
+#include "TaskScheduler.h"
+#include "YieldCurveLive.h"
+
+// Metrics from LiveTreasuryAnalyzer::runFullAnalysis, computed for one curve.
+// Order matches the columns of HistoryAnalysisTable and its CSV export.
+enum HistoryMetric : size_t {
+    kMetricPolicyRate,      // 1M yield, %
+    kMetricShortRate,       // 3M yield, %
+    kMetricYield2Y,
+    kMetricYield5Y,
+    kMetricBenchmark10Y,
+    kMetricLongRate30Y,
+    kMetricSpread2s10s,     // bps
+    kMetricSpread3m10y,
+    kMetricSpread5s30s,
+    kMetricShortEnd3m1y,    // |3M - 1Y|, bps
+    kMetricLongEnd10y30y,   // |10Y - 30Y|, bps
+    kMetricNearForward,     // 3M-15M forward, %
+    kMetricMediumForward,   // 1Y-3Y forward, %
+    kMetricLongForward,     // 5Y-10Y forward, %
+    kMetricTermPremium,     // 30Y - 10Y, bps
+    kHistoryMetricCount
+};
+
+inline constexpr const char* kHistoryMetricNames[kHistoryMetricCount] = {
+    "Policy_Rate_1M", "Short_Rate_3M", "Yield_2Y", "Yield_5Y", "Benchmark_10Y", "Long_Rate_30Y",
+    "Spread_2s10s_bps", "Spread_3m10y_bps", "Spread_5s30s_bps", "Short_End_3M1Y_bps",
+    "Long_End_10Y30Y_bps", "Forward_3M15M", "Forward_1Y3Y", "Forward_5Y10Y", "Term_Premium_bps"
+};
+
+// Analysis results for a run of history rows, one contiguous column per
+// metric plus the date and shape columns, all aligned by row.
+class HistoryAnalysisTable {
+private:
+    std::vector<int32_t> day_numbers;
+    std::vector<CurveShape> shapes;
+    std::array<std::vector<double>, kHistoryMetricCount> columns;
+
+public:
+    void resize(size_t rows) {
+        day_numbers.assign(rows, 0);
+        shapes.assign(rows, CurveShape::InsufficientData);
+        for (auto& column : columns) column.assign(rows, 0.0);
+    }
+
+    // Keeps the first `rows` rows; new rows start zeroed
+    void extend(size_t rows) {
+        day_numbers.resize(rows, 0);
+        shapes.resize(rows, CurveShape::InsufficientData);
+        for (auto& column : columns) column.resize(rows, 0.0);
+    }
+
+    size_t size() const { return day_numbers.size(); }
+    bool empty() const { return day_numbers.empty(); }
+
+    int32_t getDayNumber(size_t row) const { return day_numbers[row]; }
+    CurveShape getShape(size_t row) const { return shapes[row]; }
+    double get(size_t row, HistoryMetric metric) const { return columns[metric][row]; }
+    const std::vector<double>& getColumn(HistoryMetric metric) const { return columns[metric]; }
+    const std::vector<CurveShape>& getShapes() const { return shapes; }
+    const std::vector<int32_t>& getDayNumbers() const { return day_numbers; }
+
+    // Fill row `row` from a loaded curve. Rows are written by exactly one
+    // worker, so concurrent calls on different rows need no locking.
+    void analyzeInto(size_t row, int32_t day, const YieldCurveLive& curve) {
+        static const double key_maturities[] = {1.0/12.0, 0.25, 1.0, 2.0, 5.0, 10.0, 30.0};
+        double yields[7];
+        curve.getYields(key_maturities, yields, 7);
+        double m1 = yields[0], m3 = yields[1], y1 = yields[2], y2 = yields[3];
+        double y5 = yields[4], y10 = yields[5], y30 = yields[6];
+
+        day_numbers[row] = day;
+        shapes[row] = curve.classifyCurveShape();
+        columns[kMetricPolicyRate][row] = m1;
+        columns[kMetricShortRate][row] = m3;
+        columns[kMetricYield2Y][row] = y2;
+        columns[kMetricYield5Y][row] = y5;
+        columns[kMetricBenchmark10Y][row] = y10;
+        columns[kMetricLongRate30Y][row] = y30;
+        columns[kMetricSpread2s10s][row] = (y10 - y2) * 100;
+        columns[kMetricSpread3m10y][row] = (y10 - m3) * 100;
+        columns[kMetricSpread5s30s][row] = (y30 - y5) * 100;
+        columns[kMetricShortEnd3m1y][row] = std::abs(m3 - y1) * 100;
+        columns[kMetricLongEnd10y30y][row] = std::abs(y10 - y30) * 100;
+        columns[kMetricNearForward][row] = curve.getForwardRate(0.25, 1.25);
+        columns[kMetricMediumForward][row] = curve.getForwardRate(1.0, 3.0);
+        columns[kMetricLongForward][row] = curve.getForwardRate(5.0, 10.0);
+        columns[kMetricTermPremium][row] = (y30 - y10) * 100;
+    }
+
+    // One CSV line per row from `first_row` on; `header` adds the column
+    // names first
+    void writeCSV(std::ostream& out, bool header = true, size_t first_row = 0) const {
+        if (header) {
+            out << "Date,Curve_Shape";
+            for (const char* name : kHistoryMetricNames) out << ',' << name;
+            out << '\n';
+        }
+
+        char value[32];
+        std::string line;
+        for (size_t row = first_row; row < size(); row++) {
+            line = formatIsoDate(day_numbers[row]);
+            line += ',';
+            line += curveShapeLabel(shapes[row]);
+            for (size_t metric = 0; metric < kHistoryMetricCount; metric++) {
+                int length = std::snprintf(value, sizeof(value), ",%.4f", columns[metric][row]);
+                line.append(value, static_cast<size_t>(length));
+            }
+            line += '\n';
+            out << line;
+        }
+    }
+
+    bool exportCSV(const std::string& filename) const {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not create " << filename << std::endl;
+            return false;
+        }
+        writeCSV(file);
+        return static_cast<bool>(file);
+    }
+};
+
+// Runs the full analysis for history rows [rows.first, rows.second) on
+// `scheduler`. The history is shared read-only; rows are handed out in
+// chunks, each chunk loads its own YieldCurveLive and writes straight into
+// its own slice of the table, so nothing is locked.
+inline HistoryAnalysisTable analyzeHistory(const CurveHistory& history, std::pair<size_t, size_t> rows,
+                                           TaskScheduler& scheduler,
+                                           InterpolationMode mode = InterpolationMode::Linear) {
+    rows.second = std::min(rows.second, history.size());
+    size_t count = rows.first < rows.second ? rows.second - rows.first : 0;
+
+    HistoryAnalysisTable table;
+    table.resize(count);
+
+    scheduler.parallelFor(0, count, 0, [&](size_t begin, size_t end) {
+        YieldCurveLive curve;
+        curve.setInterpolationMode(mode);
+        for (size_t i = begin; i < end; i++) {
+            // A row that fails to load leaves the curve empty and is
+            // recorded as "Insufficient Data"
+            size_t row = rows.first + i;
+            curve.loadFromHistory(history, row);
+            table.analyzeInto(i, history.getDayNumber(row), curve);
+        }
+    });
+
+    return table;
+}
+
+// Brings a whole-history table (row i = history row i) up to date after
+// CurveHistory::refreshFromCSV: rows before `first_changed` are kept, only
+// the rest are analyzed again.
+inline void updateHistoryAnalysis(HistoryAnalysisTable& table, const CurveHistory& history, size_t first_changed,
+                                  TaskScheduler& scheduler, InterpolationMode mode = InterpolationMode::Linear) {
+    first_changed = std::min(first_changed, table.size());
+    table.extend(history.size());
+
+    scheduler.parallelFor(first_changed, history.size(), 0, [&](size_t begin, size_t end) {
+        YieldCurveLive curve;
+        curve.setInterpolationMode(mode);
+        for (size_t row = begin; row < end; row++) {
+            curve.loadFromHistory(history, row);
+            table.analyzeInto(row, history.getDayNumber(row), curve);
+        }
+    });
+}
+
+#endif // HISTORY_ANALYTICS_H
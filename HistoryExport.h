@@ -0,0 +1,186 @@
+#ifndef HISTORY_EXPORT_H
+#define HISTORY_EXPORT_H
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CurveHistory.h"
+#include "JsonWriter.h"
+#include "TaskScheduler.h"
+
+enum class HistoryJsonFormat {
+    Columns,   // one object of arrays: "dates", "maturities", "maturity_years" and
+               // "yields" keyed by tenor label, each aligned with "dates"
+    NDJSON     // one object per curve per line: {"date": ..., "<tenor>": yield, ...}
+};
+
+namespace history_export_detail {
+
+inline constexpr size_t kChunkRows = 4096;
+
+// Renders rows [0, count) in chunks of `grain` on `scheduler` (inline when
+// null) and passes each chunk's text to `emit` in row order. Chunks are
+// rendered a batch at a time, so memory stays at a few chunks per worker
+// however long the history is; each batch slot keeps its writer scratch
+// buffer across batches.
+template <class Render, class Emit>
+void renderInOrder(size_t count, size_t grain, TaskScheduler* scheduler, Render render, Emit emit) {
+    size_t batch_chunks = scheduler ? scheduler->workerCount() * 4 : 1;
+    std::vector<std::string> pieces(batch_chunks);
+    std::vector<std::vector<char>> scratch(batch_chunks);
+
+    for (size_t first = 0; first < count; first += batch_chunks * grain) {
+        size_t last = std::min(count, first + batch_chunks * grain);
+        size_t chunks = (last - first + grain - 1) / grain;
+        auto work = [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; chunk++) {
+                pieces[chunk].clear();
+                render(first + chunk * grain, std::min(last, first + (chunk + 1) * grain), pieces[chunk],
+                       scratch[chunk]);
+            }
+        };
+        if (scheduler) {
+            scheduler->parallelFor(0, chunks, 1, work);
+        } else {
+            work(0, chunks);
+        }
+        for (size_t chunk = 0; chunk < chunks; chunk++) emit(pieces[chunk]);
+    }
+}
+
+// Items of one inline array over [begin, end), rendered without brackets so
+// chunks can be joined with commas
+template <class Item>
+void renderArrayItems(size_t begin, size_t end, std::string& piece, std::vector<char>& scratch, Item item) {
+    {
+        JsonWriter json(piece, scratch, 0);
+        json.beginArray(true);
+        for (size_t i = begin; i < end; i++) item(json, i);
+        json.endArray();
+    }
+    piece.erase(0, 1);
+    piece.pop_back();
+}
+
+} // namespace history_export_detail
+
+// History rows [rows.first, rows.second) as JSON, rendered in parallel
+// chunks on `scheduler` (inline when null) and spliced into `json` in date
+// order. Unpublished yields are null; tenors the file has no column for are
+// left out.
+inline void writeHistoryJSON(JsonWriter& json, const CurveHistory& history, std::pair<size_t, size_t> rows,
+                             HistoryJsonFormat format, TaskScheduler* scheduler = nullptr) {
+    using namespace history_export_detail;
+    rows.second = std::min(rows.second, history.size());
+    rows.first = std::min(rows.first, rows.second);
+    size_t count = rows.second - rows.first;
+
+    auto emit = [&json](const std::string& piece) { json.raw(piece); };
+
+    // Only the tenors the source file has a column for
+    std::vector<size_t> tenors;
+    for (size_t tenor = 0; tenor < kHistoryTenorCount; tenor++) {
+        if (history.hasTenor(tenor)) tenors.push_back(tenor);
+    }
+
+    if (format == HistoryJsonFormat::NDJSON) {
+        renderInOrder(count, kChunkRows, scheduler, [&](size_t begin, size_t end, std::string& piece, auto& scratch) {
+            JsonWriter line(piece, scratch, 0);
+            for (size_t i = begin; i < end; i++) {
+                size_t row = rows.first + i;
+                line.beginObject();
+                line.key("date").string(history.getDate(row));
+                for (size_t tenor : tenors) {
+                    line.key(kHistoryTenorLabels[tenor]).number(history.getYield(row, tenor));
+                }
+                line.endObject();
+                line.raw("\n");
+            }
+        }, emit);
+        return;
+    }
+
+    // Columns: each array body is rendered in row chunks joined by commas
+    bool first_piece = true;
+    auto emit_items = [&](const std::string& piece) {
+        if (piece.empty()) return;
+        if (!first_piece) json.raw(",");
+        first_piece = false;
+        json.raw(piece);
+    };
+
+    json.beginObject();
+    json.key("dates").beginArray(true);
+    renderInOrder(count, kChunkRows, scheduler, [&](size_t begin, size_t end, std::string& piece, auto& scratch) {
+        renderArrayItems(begin, end, piece, scratch, [&](JsonWriter& items, size_t i) {
+            items.string(history.getDate(rows.first + i));
+        });
+    }, emit_items);
+    json.endArray();
+
+    json.key("maturities").beginArray(true);
+    for (size_t tenor : tenors) json.string(kHistoryTenorLabels[tenor]);
+    json.endArray();
+    json.key("maturity_years").beginArray(true);
+    for (size_t tenor : tenors) json.number(kHistoryTenorYears[tenor]);
+    json.endArray();
+
+    json.key("yields").beginObject();
+    for (size_t tenor : tenors) {
+        const double* column = history.getColumn(tenor).data();
+        json.key(kHistoryTenorLabels[tenor]).beginArray(true);
+        first_piece = true;
+        renderInOrder(count, kChunkRows, scheduler, [&](size_t begin, size_t end, std::string& piece, auto& scratch) {
+            renderArrayItems(begin, end, piece, scratch, [&](JsonWriter& items, size_t i) {
+                items.number(column[rows.first + i]);
+            });
+        }, emit_items);
+        json.endArray();
+    }
+    json.endObject();
+    json.endObject();
+    json.raw("\n");
+}
+
+// Returns false if the stream failed
+inline bool writeHistoryJSON(std::ostream& out, const CurveHistory& history, std::pair<size_t, size_t> rows,
+                             HistoryJsonFormat format, TaskScheduler* scheduler = nullptr) {
+    JsonWriter json(out);
+    writeHistoryJSON(json, history, rows, format, scheduler);
+    json.flush();
+    return static_cast<bool>(out);
+}
+
+// Writes rows to `filename` ("-" for stdout). Returns the number of curves
+// written, or 0 on error.
+inline size_t exportHistoryJSON(const CurveHistory& history, std::pair<size_t, size_t> rows,
+                                const std::string& filename, HistoryJsonFormat format,
+                                TaskScheduler* scheduler = nullptr) {
+    rows.second = std::min(rows.second, history.size());
+    if (rows.first >= rows.second) {
+        std::cerr << "Warning: No curves in range, " << filename << " not written" << std::endl;
+        return 0;
+    }
+
+    if (filename == "-") {
+        return writeHistoryJSON(std::cout, history, rows, format, scheduler) ? rows.second - rows.first : 0;
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create file " << filename << std::endl;
+        return 0;
+    }
+    if (!writeHistoryJSON(file, history, rows, format, scheduler)) {
+        std::cerr << "Error: Failed writing history to " << filename << std::endl;
+        return 0;
+    }
+    return rows.second - rows.first;
+}
+
+#endif // HISTORY_EXPORT_H
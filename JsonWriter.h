@@ -0,0 +1,249 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Buffered JSON writer. Output is assembled in one reusable buffer and handed
+// to the sink (a stream, or appended to a string) in large chunks, so a
+// document costs no allocation per value and no stream call per token.
+// Callers that render many small documents can lend the writer a scratch
+// buffer that outlives it, so no writer allocates one of its own.
+//
+// Doubles use std::to_chars shortest round-trip form, independent of the
+// locale; NaN and infinities are written as null. With `indent` > 0 objects
+// and arrays are pretty-printed one member per line, except containers opened
+// with `inline_items`, which keep their items on one line (long numeric
+// columns). The writer does not validate call order: keys belong in objects,
+// every begin needs its end.
+class JsonWriter {
+private:
+    struct Level {
+        bool first;
+        bool inline_items;
+    };
+
+    std::ostream* stream = nullptr;
+    std::string* target = nullptr;
+    std::unique_ptr<char[]> owned;   // empty when writing into a caller's scratch
+    char* buffer;
+    size_t capacity;
+    size_t used = 0;
+    int indent;
+    std::vector<Level> levels;
+    bool after_key = false;
+
+    static constexpr size_t kMaxTokenSize = 32;   // room for any double or int64 from to_chars
+    static constexpr size_t kMaxIndent = 64;
+
+    char* reserve(size_t bytes) {
+        if (used + bytes > capacity) flush();
+        return buffer + used;
+    }
+
+    void put(char c) {
+        if (used == capacity) flush();
+        buffer[used++] = c;
+    }
+
+    void put(std::string_view text) {
+        if (text.size() > capacity - used) {
+            flush();
+            if (text.size() > capacity) {
+                sink(text.data(), text.size());
+                return;
+            }
+        }
+        std::memcpy(buffer + used, text.data(), text.size());
+        used += text.size();
+    }
+
+    void sink(const char* data, size_t size) {
+        if (stream) stream->write(data, static_cast<std::streamsize>(size));
+        if (target) target->append(data, size);
+    }
+
+    void newline(size_t depth) {
+        static const char spaces[kMaxIndent + 1] = "                                                                ";
+        put('\n');
+        size_t width = depth * static_cast<size_t>(indent);
+        while (width > 0) {
+            size_t chunk = width < kMaxIndent ? width : kMaxIndent;
+            put(std::string_view(spaces, chunk));
+            width -= chunk;
+        }
+    }
+
+    // Separator and indentation before a key, or before a value in an array
+    void beforeItem() {
+        if (after_key) {
+            after_key = false;
+            return;
+        }
+        if (levels.empty()) return;
+
+        Level& level = levels.back();
+        if (!level.first) put(',');
+        level.first = false;
+        if (indent > 0 && !level.inline_items) newline(levels.size());
+    }
+
+    JsonWriter& open(char bracket, bool inline_items) {
+        beforeItem();
+        put(bracket);
+        levels.push_back(Level{true, inline_items});
+        return *this;
+    }
+
+    JsonWriter& close(char bracket) {
+        Level level = levels.back();
+        levels.pop_back();
+        if (indent > 0 && !level.inline_items && !level.first) newline(levels.size());
+        put(bracket);
+        return *this;
+    }
+
+    // Quoted and escaped; runs of plain characters are copied in one piece
+    void quoted(std::string_view text) {
+        put('"');
+        size_t start = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+            put(text.substr(start, i - start));
+            start = i + 1;
+            switch (c) {
+                case '"': put(std::string_view("\\\"")); break;
+                case '\\': put(std::string_view("\\\\")); break;
+                case '\n': put(std::string_view("\\n")); break;
+                case '\r': put(std::string_view("\\r")); break;
+                case '\t': put(std::string_view("\\t")); break;
+                default: {
+                    static const char hex[] = "0123456789abcdef";
+                    char escape[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                    put(std::string_view(escape, sizeof(escape)));
+                }
+            }
+        }
+        put(text.substr(start));
+        put('"');
+    }
+
+    static constexpr size_t kMinBufferSize = kMaxTokenSize * 4;
+
+    void init(size_t buffer_size) {
+        capacity = buffer_size < kMinBufferSize ? kMinBufferSize : buffer_size;
+        owned.reset(new char[capacity]);
+        buffer = owned.get();
+        levels.reserve(16);
+    }
+
+    void init(std::vector<char>& scratch) {
+        if (scratch.size() < kMinBufferSize) scratch.resize(kDefaultBufferSize);
+        capacity = scratch.size();
+        buffer = scratch.data();
+        levels.reserve(16);
+    }
+
+public:
+    static constexpr size_t kDefaultBufferSize = 256 * 1024;
+
+    explicit JsonWriter(std::ostream& out, int indent_width = 2, size_t buffer_size = kDefaultBufferSize)
+        : stream(&out), indent(indent_width) {
+        init(buffer_size);
+    }
+
+    // Appends to `out` at every flush
+    explicit JsonWriter(std::string& out, int indent_width = 2, size_t buffer_size = kDefaultBufferSize)
+        : target(&out), indent(indent_width) {
+        init(buffer_size);
+    }
+
+    // Appends to `out`, buffering in `scratch` (sized to kDefaultBufferSize on
+    // first use). The scratch must outlive the writer and not be shared with
+    // another live writer.
+    JsonWriter(std::string& out, std::vector<char>& scratch, int indent_width = 2)
+        : target(&out), indent(indent_width) {
+        init(scratch);
+    }
+
+    ~JsonWriter() { flush(); }
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    JsonWriter& beginObject(bool inline_items = false) { return open('{', inline_items); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray(bool inline_items = false) { return open('[', inline_items); }
+    JsonWriter& endArray() { return close(']'); }
+
+    JsonWriter& key(std::string_view name) {
+        beforeItem();
+        quoted(name);
+        put(':');
+        if (indent > 0) put(' ');
+        after_key = true;
+        return *this;
+    }
+
+    JsonWriter& number(double value) {
+        beforeItem();
+        if (!std::isfinite(value)) {
+            put(std::string_view("null"));
+            return *this;
+        }
+        char* out = reserve(kMaxTokenSize);
+        used = static_cast<size_t>(std::to_chars(out, out + kMaxTokenSize, value).ptr - buffer);
+        return *this;
+    }
+
+    JsonWriter& integer(int64_t value) {
+        beforeItem();
+        char* out = reserve(kMaxTokenSize);
+        used = static_cast<size_t>(std::to_chars(out, out + kMaxTokenSize, value).ptr - buffer);
+        return *this;
+    }
+
+    JsonWriter& boolean(bool value) {
+        beforeItem();
+        put(value ? std::string_view("true") : std::string_view("false"));
+        return *this;
+    }
+
+    JsonWriter& null() {
+        beforeItem();
+        put(std::string_view("null"));
+        return *this;
+    }
+
+    JsonWriter& string(std::string_view text) {
+        beforeItem();
+        quoted(text);
+        return *this;
+    }
+
+    // Verbatim text outside the structure, e.g. a trailing newline
+    JsonWriter& raw(std::string_view text) {
+        put(text);
+        return *this;
+    }
+
+    // Hand everything buffered so far to the sink
+    void flush() {
+        if (used == 0) return;
+        sink(buffer, used);
+        used = 0;
+    }
+
+    bool good() const { return !stream || static_cast<bool>(*stream); }
+};
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,406 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "CurveHistory.h"
+#include "TreasuryCsv.h"
+#include "TreasuryDates.h"
+#include "YieldCurveLive.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Resident query server: loads nothing itself, answers from an already
+// parsed CurveHistory over a Unix domain socket, and keeps every curve it has
+// compiled so repeat queries for a date cost only the evaluation.
+//
+// Line protocol, one request per line, one response line per request:
+//
+//   YIELD   <date> <maturity>...          -> OK <yield%>...
+//   FORWARD <date> <from> <to> [...]      -> OK <forward%>...
+//   SPREAD  <date> <from> <to> [...]      -> OK <spread bps>...
+//   SHAPE   <date>                        -> OK <date> <shape label>
+//   INFO                                  -> OK <first date> <last date> <curves>
+//   PING                                  -> OK
+//   QUIT                                  -> closes the connection
+//
+// <date> is YYYY-MM-DD (the curve in force that day) or "latest". Errors are
+// answered with "ERR <reason>" and the connection stays open. All clients are
+// served from one poll() loop: each query is a few microseconds of work, so a
+// single thread keeps tail latency lower than handing requests to workers.
+class CurveQueryServer {
+private:
+    const CurveHistory& history;
+    InterpolationMode interpolation;
+    std::vector<std::unique_ptr<YieldCurveLive>> curves;   // by history row, compiled on first use
+    std::atomic<bool> running{false};
+    std::string socket_path;
+    int listen_fd = -1;
+    std::function<void()> idle_task;
+
+    static constexpr size_t kMaxRequestLine = 4096;
+    static constexpr size_t kMaxOutbox = 1024 * 1024;   // stop reading a client that does not read replies
+    static constexpr int kPollIntervalMs = 200;   // how quickly stop() is noticed
+#if defined(MSG_NOSIGNAL)
+    static constexpr int kSendFlags = MSG_NOSIGNAL;   // a vanished client must not raise SIGPIPE
+#else
+    static constexpr int kSendFlags = 0;
+#endif
+
+    const YieldCurveLive* curveFor(std::string_view date, std::string& error) {
+        if (history.empty()) {
+            error = "no data loaded";
+            return nullptr;
+        }
+
+        size_t row = history.latestRow();
+        if (date != "latest") {
+            int32_t day;
+            if (!parseIsoDate(date, day)) {
+                error = "invalid date";
+                return nullptr;
+            }
+            row = history.findNearestPrior(day);
+            if (row >= history.size()) {
+                error = "no curve on or before date";
+                return nullptr;
+            }
+        }
+
+        if (!curves[row]) {
+            auto curve = std::make_unique<YieldCurveLive>();
+            curve->setInterpolationMode(interpolation);
+            curve->loadFromHistory(history, row);
+            curves[row] = std::move(curve);
+        }
+        return curves[row].get();
+    }
+
+    static size_t splitWords(std::string_view line, std::string_view* words, size_t capacity) {
+        size_t count = 0;
+        size_t pos = 0;
+        while (count < capacity) {
+            pos = line.find_first_not_of(" \t", pos);
+            if (pos == std::string_view::npos) break;
+            size_t end = line.find_first_of(" \t", pos);
+            if (end == std::string_view::npos) end = line.size();
+            words[count++] = line.substr(pos, end - pos);
+            pos = end;
+        }
+        return count;
+    }
+
+    static void appendValue(std::string& response, double value) {
+        char buffer[32];
+        int length = std::snprintf(buffer, sizeof(buffer), " %.6f", value);
+        response.append(buffer, static_cast<size_t>(length));
+    }
+
+public:
+    CurveQueryServer(const CurveHistory& source, InterpolationMode mode = InterpolationMode::Linear)
+        : history(source), interpolation(mode), curves(source.size()) {}
+
+    ~CurveQueryServer() { close(); }
+
+    CurveQueryServer(const CurveQueryServer&) = delete;
+    CurveQueryServer& operator=(const CurveQueryServer&) = delete;
+
+    // Run `task` on the server thread between poll rounds, at least every
+    // kPollIntervalMs; it may change the history and call historyChanged()
+    void setIdleTask(std::function<void()> task) { idle_task = std::move(task); }
+
+    // Drop compiled curves from `first_row` on after the history changed
+    void historyChanged(size_t first_row) {
+        curves.resize(history.size());
+        for (size_t row = first_row; row < curves.size(); row++) curves[row].reset();
+    }
+
+    // Answer one request line (without its newline) into `response`, which
+    // gets its trailing newline. Returns false when the client asked to quit.
+    bool handleRequest(std::string_view line, std::string& response) {
+        constexpr size_t kMaxWords = 66;
+        std::string_view words[kMaxWords];
+        size_t count = splitWords(line, words, kMaxWords);
+
+        response.clear();
+        if (count == 0) {
+            response = "ERR empty request\n";
+            return true;
+        }
+
+        std::string_view command = words[0];
+        if (command == "QUIT") return false;
+        if (command == "PING") {
+            response = "OK\n";
+            return true;
+        }
+        if (command == "INFO") {
+            if (history.empty()) {
+                response = "ERR no data loaded\n";
+                return true;
+            }
+            response = "OK " + history.getDate(0) + " " + history.getDate(history.latestRow()) + " " +
+                       std::to_string(history.size()) + "\n";
+            return true;
+        }
+
+        bool yield = command == "YIELD";
+        bool forward = command == "FORWARD";
+        bool spread = command == "SPREAD";
+        bool shape = command == "SHAPE";
+        if (!yield && !forward && !spread && !shape) {
+            response = "ERR unknown command\n";
+            return true;
+        }
+        if (count < 2) {
+            response = "ERR missing date\n";
+            return true;
+        }
+
+        std::string error;
+        const YieldCurveLive* curve = curveFor(words[1], error);
+        if (!curve) {
+            response = "ERR " + error + "\n";
+            return true;
+        }
+
+        if (shape) {
+            response = "OK " + curve->getDate() + " " + curve->getCurveShape() + "\n";
+            return true;
+        }
+
+        double values[kMaxWords];
+        size_t value_count = count - 2;
+        for (size_t i = 0; i < value_count; i++) {
+            if (!parseCsvDouble(words[i + 2], values[i])) {
+                response = "ERR invalid maturity\n";
+                return true;
+            }
+        }
+        if (value_count == 0 || (!yield && value_count % 2 != 0)) {
+            response = yield ? "ERR missing maturity\n" : "ERR expected from/to pairs\n";
+            return true;
+        }
+
+        response = "OK";
+        if (yield) {
+            double yields[kMaxWords];
+            curve->getYields(values, yields, value_count);
+            for (size_t i = 0; i < value_count; i++) appendValue(response, yields[i]);
+        } else {
+            for (size_t i = 0; i + 1 < value_count; i += 2) {
+                appendValue(response, forward ? curve->getForwardRate(values[i], values[i + 1])
+                                              : curve->getSpread(values[i], values[i + 1]) * 100);
+            }
+        }
+        response += '\n';
+        return true;
+    }
+
+#if !defined(_WIN32)
+    // True when nothing listens on the socket at `address` any more. A probe
+    // that fails for any reason but ECONNREFUSED counts as in use, so an
+    // unclear answer never unlinks a live server's path.
+    static bool socketIsStale(const sockaddr_un& address) {
+        int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe < 0) return false;
+        ::fcntl(probe, F_SETFL, ::fcntl(probe, F_GETFL, 0) | O_NONBLOCK);
+        bool refused = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 &&
+                       errno == ECONNREFUSED;
+        ::close(probe);
+        return refused;
+    }
+
+    // Bind and listen on `path`, replacing a stale socket file
+    bool listen(const std::string& path) {
+        close();
+
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Error: Socket path too long: " << path << std::endl;
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+        // Replace a stale socket, but never delete anything else at the path
+        // and never take it from a server still listening there
+        struct stat existing;
+        bool stale_socket = ::lstat(path.c_str(), &existing) == 0;
+        if (stale_socket && !S_ISSOCK(existing.st_mode)) {
+            std::cerr << "Error: " << path << " exists and is not a socket" << std::endl;
+            return false;
+        }
+        if (stale_socket && !socketIsStale(address)) {
+            std::cerr << "Error: " << path << " is already in use" << std::endl;
+            return false;
+        }
+
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            std::cerr << "Error: Could not create socket: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        if (stale_socket) ::unlink(path.c_str());
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listen_fd, 64) != 0) {
+            std::cerr << "Error: Could not listen on " << path << ": " << std::strerror(errno) << std::endl;
+            ::close(listen_fd);
+            listen_fd = -1;
+            return false;
+        }
+
+        ::fcntl(listen_fd, F_SETFL, ::fcntl(listen_fd, F_GETFL, 0) | O_NONBLOCK);
+        socket_path = path;
+        return true;
+    }
+
+    // Serve clients until stop() is called. Client sockets are non-blocking
+    // and replies queue in a per-client outbox, so a client that stops
+    // reading only stalls itself: past kMaxOutbox its requests are left
+    // unread until the outbox drains.
+    void run() {
+        if (listen_fd < 0) return;
+        running.store(true);
+
+        struct Client {
+            int fd;
+            std::string pending;    // bytes received after the last answered line
+            std::string outbox;     // replies not yet sent
+            size_t sent = 0;
+            bool closing = false;   // close once the outbox drains
+        };
+        std::vector<Client> clients;
+        std::vector<pollfd> fds;
+        std::string response;
+        char buffer[16384];
+
+        auto has_room = [](const Client& client) { return client.outbox.size() - client.sent < kMaxOutbox; };
+
+        while (running.load(std::memory_order_relaxed)) {
+            if (idle_task) idle_task();
+
+            fds.clear();
+            fds.push_back(pollfd{listen_fd, POLLIN, 0});
+            for (const auto& client : clients) {
+                short events = client.closing || !has_room(client) ? 0 : POLLIN;
+                if (client.sent < client.outbox.size()) events |= POLLOUT;
+                fds.push_back(pollfd{client.fd, events, 0});
+            }
+
+            int ready = ::poll(fds.data(), fds.size(), kPollIntervalMs);
+            if (ready <= 0) continue;
+
+            // Serve existing clients before accepting, so indices line up with fds
+            for (size_t i = clients.size(); i-- > 0;) {
+                short events = fds[i + 1].revents;
+                if (events == 0) continue;
+
+                Client& client = clients[i];
+                bool keep = (events & (POLLERR | POLLNVAL)) == 0;
+
+                if (keep && (events & (POLLIN | POLLHUP)) && !client.closing && has_room(client)) {
+                    ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+                    if (received > 0) {
+                        client.pending.append(buffer, static_cast<size_t>(received));
+                    } else if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                        keep = false;
+                    }
+                }
+
+                while (keep) {
+                    // Answer complete lines while the outbox has room
+                    size_t start = 0;
+                    while (!client.closing && has_room(client)) {
+                        size_t newline = client.pending.find('\n', start);
+                        if (newline == std::string::npos) break;
+                        std::string_view line(client.pending.data() + start, newline - start);
+                        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                        client.closing = !handleRequest(line, response);
+                        client.outbox += response;
+                        start = newline + 1;
+                    }
+                    client.pending.erase(0, start);
+                    if (!client.closing && client.pending.size() > kMaxRequestLine &&
+                        client.pending.find('\n') == std::string::npos) {
+                        client.outbox += "ERR request too long\n";
+                        client.closing = true;
+                    }
+
+                    // Send as much as the socket takes; the rest waits for POLLOUT
+                    while (client.sent < client.outbox.size()) {
+                        ssize_t n = ::send(client.fd, client.outbox.data() + client.sent,
+                                           client.outbox.size() - client.sent, kSendFlags);
+                        if (n > 0) {
+                            client.sent += static_cast<size_t>(n);
+                        } else {
+                            keep = n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+                            break;
+                        }
+                    }
+                    if (client.sent < client.outbox.size()) break;
+
+                    client.outbox.clear();
+                    client.sent = 0;
+                    if (client.closing) keep = false;
+                    // Drained: lines held back while the outbox was full can go now
+                    if (client.pending.find('\n') == std::string::npos) break;
+                }
+
+                if (!keep) {
+                    ::close(client.fd);
+                    clients.erase(clients.begin() + static_cast<std::ptrdiff_t>(i));
+                }
+            }
+
+            if (fds[0].revents & POLLIN) {
+                int fd;
+                while ((fd = ::accept(listen_fd, nullptr, nullptr)) >= 0) {
+                    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+                    clients.push_back(Client{fd, {}, {}, 0, false});
+                }
+            }
+        }
+
+        for (const auto& client : clients) ::close(client.fd);
+    }
+
+    // Safe to call from another thread or a signal handler
+    void stop() { running.store(false); }
+
+    void close() {
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+            listen_fd = -1;
+            ::unlink(socket_path.c_str());
+        }
+    }
+#else
+    bool listen(const std::string&) {
+        std::cerr << "Error: Query server mode needs Unix domain sockets" << std::endl;
+        return false;
+    }
+    void run() {}
+    void stop() {}
+    void close() {}
+#endif
+};
+
+#endif // QUERY_SERVER_H
@@ -0,0 +1,210 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Counts the outstanding tasks of one batch so a caller can wait for just
+// that batch while the scheduler keeps running other work. The first
+// exception a task throws is kept for wait() to rethrow.
+class TaskGroup {
+private:
+    friend class TaskScheduler;
+    std::atomic<size_t> pending{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    void fail(std::exception_ptr thrown) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::move(thrown);
+    }
+
+public:
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+};
+
+// Work-stealing task scheduler. Each worker owns a deque: it pushes and pops
+// its own tasks at the back (newest first, cache-warm) and, when empty,
+// steals from the front of another worker's deque (oldest first, usually the
+// largest remaining piece of work).
+//
+// A scheduler built for N workers starts N - 1 threads; the thread that calls
+// wait() is the Nth and runs tasks too, so N bounds the cores one analyzer
+// uses and TaskScheduler(1) runs everything inline on the caller.
+class TaskScheduler {
+private:
+    struct Task {
+        std::function<void()> run;
+        TaskGroup* group;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;   // queues[0] belongs to waiting callers
+    std::vector<std::thread> threads;
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> next_queue{0};
+    bool stopping = false;
+
+    // Queue index of the current thread within `owner`, if it is a worker
+    inline static thread_local const TaskScheduler* owner = nullptr;
+    inline static thread_local size_t owner_index = 0;
+
+    size_t localQueue() {
+        if (owner == this) return owner_index;
+        return next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    bool popLocal(size_t index, Task& task) {
+        WorkerQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, Task& task) {
+        for (size_t offset = 1; offset < queues.size(); offset++) {
+            WorkerQueue& queue = *queues[(thief + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool tryRunOne(size_t index) {
+        Task task;
+        if (!popLocal(index, task) && !steal(index, task)) return false;
+        queued.fetch_sub(1, std::memory_order_relaxed);
+
+        // A throw must neither escape a worker thread nor skip the count below,
+        // or wait() would return while the batch still runs
+        try {
+            task.run();
+        } catch (...) {
+            task.group->fail(std::current_exception());
+        }
+        if (task.group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Last task of a batch: a caller may be sleeping in wait()
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            wake.notify_all();
+        }
+        return true;
+    }
+
+    void workerLoop(size_t index) {
+        owner = this;
+        owner_index = index;
+        while (true) {
+            if (tryRunOne(index)) continue;
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping && queued.load(std::memory_order_relaxed) == 0) return;
+        }
+    }
+
+public:
+    // `workers` = 0 uses one worker per hardware thread
+    explicit TaskScheduler(unsigned workers = 0) {
+        if (workers == 0) workers = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < workers; i++) queues.push_back(std::make_unique<WorkerQueue>());
+        threads.reserve(workers - 1);
+        for (unsigned i = 1; i < workers; i++) threads.emplace_back(&TaskScheduler::workerLoop, this, i);
+    }
+
+    ~TaskScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    size_t workerCount() const { return queues.size(); }
+
+    // Queue `task` as part of `group`. Tasks submitted from a worker go to
+    // that worker's own deque; others are spread round-robin.
+    void submit(TaskGroup& group, std::function<void()> task) {
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        queued.fetch_add(1, std::memory_order_relaxed);   // Before the push, so the count never underflows
+        WorkerQueue& queue = *queues[localQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(Task{std::move(task), &group});
+        }
+
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        wake.notify_one();
+    }
+
+    // Run queued tasks on the calling thread until every task of `group` has
+    // finished, then rethrow the first exception one of them threw. Safe to
+    // call from inside a task (nested parallelism).
+    void wait(TaskGroup& group) {
+        size_t index = owner == this ? owner_index : 0;
+        while (!group.done()) {
+            if (tryRunOne(index)) continue;
+
+            // Nothing left to run here: the remaining tasks are in flight on
+            // other workers, so sleep until one of them finishes
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [&] { return group.done() || queued.load(std::memory_order_relaxed) > 0; });
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(group.error_mutex);
+            error = std::move(group.error);
+            group.error = nullptr;
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Call body(chunk_begin, chunk_end) over [begin, end) in chunks of at
+    // most `grain` items (0 = about four chunks per worker) and wait for all
+    // of them. Chunks are submitted up front, so idle workers steal them. If
+    // a chunk throws, the others still finish before the exception reaches
+    // the caller.
+    template <class Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, Body body) {
+        if (begin >= end) return;
+        size_t count = end - begin;
+        if (grain == 0) grain = std::max<size_t>(1, count / (workerCount() * 4));
+        if (workerCount() == 1 || count <= grain) {
+            body(begin, end);
+            return;
+        }
+
+        TaskGroup group;
+        for (size_t chunk = begin; chunk < end; chunk += grain) {
+            size_t chunk_end = std::min(end, chunk + grain);
+            submit(group, [&body, chunk, chunk_end] { body(chunk, chunk_end); });
+        }
+        wait(group);
+    }
+};
+
+#endif // TASK_SCHEDULER_H
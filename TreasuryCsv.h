@@ -0,0 +1,420 @@
+#ifndef TREASURY_CSV_H
+#define TREASURY_CSV_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "TreasuryDates.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-only view of a whole file. Uses mmap where available and falls back to
+// reading the file into memory, so callers always see one contiguous buffer.
+class MappedFile {
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool is_open_ = false;
+    bool mapped_ = false;
+    std::string fallback_;
+
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filename) { open(filename); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            size_ = other.size_;
+            is_open_ = other.is_open_;
+            mapped_ = other.mapped_;
+            fallback_ = std::move(other.fallback_);
+            data_ = mapped_ ? other.data_ : fallback_.data();
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.is_open_ = false;
+            other.mapped_ = false;
+        }
+        return *this;
+    }
+
+    bool open(const std::string& filename) {
+        close();
+#if !defined(_WIN32)
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                ::madvise(addr, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(addr);
+                mapped_ = true;
+            }
+        }
+        ::close(fd);
+
+        if (mapped_ || size_ == 0) {
+            is_open_ = true;
+            return true;
+        }
+#endif
+        // Portable path: one bulk read instead of line-by-line streaming
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+        fallback_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        data_ = fallback_.data();
+        size_ = fallback_.size();
+        is_open_ = true;
+        return true;
+    }
+
+    void close() {
+#if !defined(_WIN32)
+        if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        is_open_ = false;
+        mapped_ = false;
+        fallback_.clear();
+    }
+
+    bool isOpen() const { return is_open_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+};
+
+// Walks a buffer line by line without copying. A trailing '\r' is stripped so
+// files exported on Windows parse the same as Unix ones.
+class CsvLineReader {
+private:
+    std::string_view buffer_;
+    size_t pos_ = 0;
+
+public:
+    explicit CsvLineReader(std::string_view buffer) : buffer_(buffer) {}
+
+    bool next(std::string_view& line) {
+        if (pos_ >= buffer_.size()) return false;
+
+        size_t end = buffer_.find('\n', pos_);
+        if (end == std::string_view::npos) end = buffer_.size();
+
+        line = buffer_.substr(pos_, end - pos_);
+        pos_ = end + 1;
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return true;
+    }
+
+    // Byte offset of the first unread line
+    size_t offset() const { return pos_ < buffer_.size() ? pos_ : buffer_.size(); }
+};
+
+// Walks a buffer from the last line towards the first, so the newest row of
+// a date-ordered file is found without reading the rest of it.
+class CsvReverseLineReader {
+private:
+    std::string_view buffer_;
+    size_t end_;
+    bool done_ = false;
+
+public:
+    explicit CsvReverseLineReader(std::string_view buffer) : buffer_(buffer), end_(buffer.size()) {
+        // A final newline terminates the last line rather than starting an empty one
+        if (end_ > 0 && buffer_[end_ - 1] == '\n') end_--;
+    }
+
+    bool previous(std::string_view& line) {
+        if (done_) return false;
+
+        size_t newline = end_ == 0 ? std::string_view::npos : buffer_.rfind('\n', end_ - 1);
+        size_t start = newline == std::string_view::npos ? 0 : newline + 1;
+
+        line = buffer_.substr(start, end_ - start);
+        if (newline == std::string_view::npos) {
+            done_ = true;
+        } else {
+            end_ = newline;
+        }
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return true;
+    }
+};
+
+// Day number of the date in the first column of the line starting at `start`
+inline bool csvLineDay(std::string_view body, size_t start, int32_t& day) {
+    size_t end = body.find_first_of(",\n", start);
+    if (end == std::string_view::npos) end = body.size();
+    return parseIsoDate(body.substr(start, end - start), day);
+}
+
+// Byte offset of the first line in a date-ordered CSV body dated on or after
+// `day`. Bisects byte offsets and realigns each probe to the next line start,
+// so only O(log n) lines of the mapping are ever touched.
+inline size_t lowerBoundRowOffset(std::string_view body, int32_t day) {
+    size_t lo = 0;
+    size_t hi = body.size();
+
+    while (hi - lo > 512) {
+        size_t mid = lo + (hi - lo) / 2;
+        size_t newline = body.find('\n', mid);
+        if (newline == std::string_view::npos || newline + 1 >= hi) break;
+
+        size_t start = newline + 1;
+        int32_t probe;
+        if (!csvLineDay(body, start, probe)) break;
+
+        if (probe < day) {
+            lo = start;
+        } else {
+            hi = start;
+        }
+    }
+
+    // Finish with a short linear walk inside the remaining window
+    size_t pos = lo;
+    while (pos < hi) {
+        int32_t probe;
+        if (csvLineDay(body, pos, probe) && probe >= day) return pos;
+
+        size_t newline = body.find('\n', pos);
+        if (newline == std::string_view::npos) break;
+        pos = newline + 1;
+    }
+    return hi;
+}
+
+// Fixed-capacity field list for one CSV row. Fields are views into the line
+// they were split from, so a row costs no heap allocation.
+constexpr size_t kMaxCsvFields = 64;
+
+struct CsvFields {
+    std::array<std::string_view, kMaxCsvFields> field;
+    size_t count = 0;
+
+    size_t size() const { return count; }
+    std::string_view operator[](size_t i) const { return field[i]; }
+};
+
+inline void splitCsvFields(std::string_view line, CsvFields& out) {
+    out.count = 0;
+    size_t start = 0;
+    while (out.count < kMaxCsvFields) {
+        size_t comma = line.find(',', start);
+        if (comma == std::string_view::npos) {
+            out.field[out.count++] = line.substr(start);
+            break;
+        }
+        out.field[out.count++] = line.substr(start, comma - start);
+        start = comma + 1;
+    }
+}
+
+// Bit i set where block[i] is ',' or '\n', for one 64-byte block. Compares
+// 32 (AVX2) or 16 (SSE2) bytes per instruction; other targets use the
+// byte loop, which compilers vectorize on their own where they can.
+inline uint64_t csvDelimiterMask(const char* block) {
+#if defined(__AVX2__)
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    uint64_t mask = 0;
+    for (int half = 0; half < 2; half++) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + half * 32));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, comma), _mm256_cmpeq_epi8(bytes, newline));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hits))) << (half * 32);
+    }
+    return mask;
+#elif defined(__SSE2__)
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    uint64_t mask = 0;
+    for (int quarter = 0; quarter < 4; quarter++) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + quarter * 16));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, newline));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(hits))) << (quarter * 16);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (int i = 0; i < 64; i++) {
+        mask |= static_cast<uint64_t>(block[i] == ',' || block[i] == '\n') << i;
+    }
+    return mask;
+#endif
+}
+
+inline int csvLowestBit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int bit = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// Row tokenizer over a structural index, simdjson-style: a window of the
+// buffer is scanned 64 bytes at a time for ',' and '\n', the hits are turned
+// into offsets, and rows and fields are then cut from those offsets without
+// looking at the bytes in between. The window keeps the index in cache
+// however large the buffer is. Same field rules as splitCsvFields; a
+// trailing '\r' is stripped as CsvLineReader does.
+class CsvStructuralReader {
+private:
+    static constexpr size_t kWindowBytes = 16 * 1024;
+
+    std::string_view buffer_;
+    size_t scanned_ = 0;        // bytes indexed so far
+    size_t pos_ = 0;            // start of the next row
+    size_t window_ = 0;         // buffer offset of the current window
+    std::unique_ptr<uint32_t[]> delimiters_;   // window-relative offsets of ',' and '\n'
+    size_t count_ = 0;
+    size_t next_ = 0;           // first unconsumed entry of delimiters_
+
+    // Index the next window; false once the whole buffer is indexed
+    bool refill() {
+        if (scanned_ >= buffer_.size()) return false;
+
+        window_ = scanned_;
+        count_ = 0;
+        next_ = 0;
+        const char* data = buffer_.data() + window_;
+        size_t size = std::min(buffer_.size() - window_, kWindowBytes);
+        uint32_t* out = delimiters_.get();
+
+        size_t i = 0;
+        for (; i + 64 <= size; i += 64) {
+            uint64_t mask = csvDelimiterMask(data + i);
+            while (mask != 0) {
+                *out++ = static_cast<uint32_t>(i) + static_cast<uint32_t>(csvLowestBit(mask));
+                mask &= mask - 1;
+            }
+        }
+        for (; i < size; i++) {
+            if (data[i] == ',' || data[i] == '\n') *out++ = static_cast<uint32_t>(i);
+        }
+
+        count_ = static_cast<size_t>(out - delimiters_.get());
+        scanned_ = window_ + size;
+        return true;
+    }
+
+public:
+    explicit CsvStructuralReader(std::string_view buffer)
+        : buffer_(buffer), delimiters_(new uint32_t[kWindowBytes]) {}
+
+    // Next row as a line and its fields (views into the buffer)
+    bool next(std::string_view& line, CsvFields& fields) {
+        if (pos_ >= buffer_.size()) return false;
+
+        fields.count = 0;
+        size_t start = pos_;
+        size_t field_start = pos_;
+        size_t end = buffer_.size();
+        for (;;) {
+            // A window can hold no delimiter at all (one very long field)
+            while (next_ == count_) {
+                if (!refill()) break;
+            }
+            if (next_ == count_) break;   // last row has no newline
+
+            size_t delimiter = window_ + delimiters_[next_++];
+            if (buffer_[delimiter] == '\n') {
+                end = delimiter;
+                break;
+            }
+            if (fields.count < kMaxCsvFields) {
+                fields.field[fields.count++] = buffer_.substr(field_start, delimiter - field_start);
+            }
+            field_start = delimiter + 1;
+        }
+        pos_ = end + 1;
+
+        size_t line_end = end;
+        if (line_end > start && buffer_[line_end - 1] == '\r') line_end--;
+        line = buffer_.substr(start, line_end - start);
+        if (fields.count < kMaxCsvFields) {
+            field_start = std::min(field_start, line_end);
+            fields.field[fields.count++] = buffer_.substr(field_start, line_end - field_start);
+        }
+        return true;
+    }
+
+    // Byte offset of the first unread row
+    size_t offset() const { return pos_ < buffer_.size() ? pos_ : buffer_.size(); }
+};
+
+// Outcome of parsing one numeric CSV field
+enum class CsvValueStatus {
+    Ok,
+    Missing,   // empty field
+    NoData,    // explicit no-data marker: H.15 "ND" on market holidays, "NA", "N/A" or FRED's "."
+    Invalid    // anything else that is not a finite number
+};
+
+inline bool isCsvNoDataMarker(std::string_view field) {
+    return field == "ND" || field == "NA" || field == "N/A" || field == ".";
+}
+
+// Parses a numeric field in place with std::from_chars: no std::string, no
+// locale, no exceptions. Surrounding blanks and a leading '+' are accepted;
+// everything else in the field must be the number.
+inline CsvValueStatus parseCsvValue(std::string_view field, double& value) {
+    while (!field.empty() && (field.front() == ' ' || field.front() == '\t')) field.remove_prefix(1);
+    while (!field.empty() && (field.back() == ' ' || field.back() == '\t')) field.remove_suffix(1);
+    if (field.empty()) return CsvValueStatus::Missing;
+    if (isCsvNoDataMarker(field)) return CsvValueStatus::NoData;
+
+    const char* first = field.data();
+    const char* last = first + field.size();
+    if (*first == '+' && last - first > 1 && first[1] != '-') first++;
+
+    auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last || !std::isfinite(value)) return CsvValueStatus::Invalid;
+    return CsvValueStatus::Ok;
+}
+
+// True only for a finite number; see parseCsvValue for why a field failed
+inline bool parseCsvDouble(std::string_view field, double& value) {
+    return parseCsvValue(field, value) == CsvValueStatus::Ok;
+}
+
+#endif // TREASURY_CSV_H
@@ -0,0 +1,144 @@
+#ifndef TREASURY_DATES_H
+#define TREASURY_DATES_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Calendar dates as day numbers (days since 1970-01-01), so date lookups are
+// integer comparisons instead of string matching.
+
+constexpr int32_t daysFromCivil(int y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+constexpr unsigned daysInMonth(int y, unsigned m) {
+    constexpr unsigned lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    return (m == 2 && leap) ? 29 : lengths[m - 1];
+}
+
+inline std::string formatIsoDate(int32_t day) {
+    // Inverse of daysFromCivil
+    int32_t z = day + 719468;
+    const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    const int y = static_cast<int>(yoe) + era * 400 + (m <= 2);
+
+    char buffer[16];
+    buffer[0] = static_cast<char>('0' + (y / 1000) % 10);
+    buffer[1] = static_cast<char>('0' + (y / 100) % 10);
+    buffer[2] = static_cast<char>('0' + (y / 10) % 10);
+    buffer[3] = static_cast<char>('0' + y % 10);
+    buffer[4] = '-';
+    buffer[5] = static_cast<char>('0' + m / 10);
+    buffer[6] = static_cast<char>('0' + m % 10);
+    buffer[7] = '-';
+    buffer[8] = static_cast<char>('0' + d / 10);
+    buffer[9] = static_cast<char>('0' + d % 10);
+    return std::string(buffer, 10);
+}
+
+namespace treasury_dates_detail {
+
+inline bool parseDigits(std::string_view text, size_t pos, size_t count, int& value) {
+    if (pos + count > text.size()) return false;
+    value = 0;
+    for (size_t i = pos; i < pos + count; i++) {
+        unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+        if (digit > 9) return false;
+        value = value * 10 + static_cast<int>(digit);
+    }
+    return true;
+}
+
+} // namespace treasury_dates_detail
+
+// Parses "YYYY-MM-DD" into a day number
+inline bool parseIsoDate(std::string_view text, int32_t& day) {
+    using treasury_dates_detail::parseDigits;
+    int y, m, d;
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-' ||
+        !parseDigits(text, 0, 4, y) || !parseDigits(text, 5, 2, m) || !parseDigits(text, 8, 2, d)) {
+        return false;
+    }
+    if (m < 1 || m > 12 || d < 1 || d > static_cast<int>(daysInMonth(y, m))) return false;
+
+    day = daysFromCivil(y, static_cast<unsigned>(m), static_cast<unsigned>(d));
+    return true;
+}
+
+// Inclusive range of day numbers selected by a user date query
+struct DateRange {
+    int32_t first = 0;
+    int32_t last = 0;
+    bool single_day = false;
+
+    bool contains(int32_t day) const { return day >= first && day <= last; }
+};
+
+// Accepts "YYYY-MM-DD", "YYYY-MM", "YYYY", "YYYY-Qn" and "A..B" where A and B
+// are any of those forms ("2024-Q3", "2024-07-15..2024-08").
+inline bool parseDateQuery(std::string_view query, DateRange& range) {
+    using treasury_dates_detail::parseDigits;
+
+    size_t dots = query.find("..");
+    if (dots != std::string_view::npos) {
+        DateRange from, to;
+        if (!parseDateQuery(query.substr(0, dots), from) ||
+            !parseDateQuery(query.substr(dots + 2), to) || from.first > to.last) {
+            return false;
+        }
+        range.first = from.first;
+        range.last = to.last;
+        range.single_day = range.first == range.last;
+        return true;
+    }
+
+    int y, m;
+    if (!parseDigits(query, 0, 4, y)) return false;
+
+    if (query.size() == 4) {
+        range.first = daysFromCivil(y, 1, 1);
+        range.last = daysFromCivil(y, 12, 31);
+        range.single_day = false;
+        return true;
+    }
+
+    if (query.size() == 7 && query[4] == '-' && (query[5] == 'Q' || query[5] == 'q')) {
+        int quarter = query[6] - '0';
+        if (quarter < 1 || quarter > 4) return false;
+        unsigned first_month = static_cast<unsigned>(quarter - 1) * 3 + 1;
+        range.first = daysFromCivil(y, first_month, 1);
+        range.last = daysFromCivil(y, first_month + 2, daysInMonth(y, first_month + 2));
+        range.single_day = false;
+        return true;
+    }
+
+    if (query.size() == 7 && query[4] == '-' && parseDigits(query, 5, 2, m)) {
+        if (m < 1 || m > 12) return false;
+        range.first = daysFromCivil(y, static_cast<unsigned>(m), 1);
+        range.last = daysFromCivil(y, static_cast<unsigned>(m), daysInMonth(y, static_cast<unsigned>(m)));
+        range.single_day = false;
+        return true;
+    }
+
+    int32_t day;
+    if (!parseIsoDate(query, day)) return false;
+    range.first = day;
+    range.last = day;
+    range.single_day = true;
+    return true;
+}
+
+#endif // TREASURY_DATES_H
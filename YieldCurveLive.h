@@ -2,7 +2,6 @@
 #define YIELDCURVE_LIVE_H
 
 #include <vector>
-#include <map>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -11,227 +10,647 @@
 #include <cmath>
 #include <iomanip>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "CurveHistory.h"
+#include "JsonWriter.h"
+#include "TreasuryCsv.h"
 
 struct YieldPoint {
     double maturity;  // in years
     double yield;     // in percentage
-    std::string maturity_label;
-    
-    YieldPoint(double m, double y, const std::string& label) 
-        : maturity(m), yield(y), maturity_label(label) {}
+    TenorId tenor;    // index into kHistoryTenorLabels
+
+    YieldPoint() = default;
+    constexpr YieldPoint(double m, double y, TenorId id) : maturity(m), yield(y), tenor(id) {}
+
+    std::string_view label() const { return tenorLabel(tenor); }
 };
+static_assert(std::is_trivially_copyable_v<YieldPoint>, "YieldPoint is copied as raw memory");
 
-class YieldCurveLive {
-private:
-    std::vector<YieldPoint> yield_points;
-    std::string curve_date;
-    std::map<std::string, double> maturity_map;
-    
-    // Initialize maturity mappings for real Treasury data
-    void initializeMaturityMap() {
-        maturity_map = {
-            {"1MO", 1.0/12.0},    // 0.083 years
-            {"3MO", 0.25},        // 0.25 years  
-            {"6MO", 0.5},         // 0.5 years
-            {"1Y", 1.0},          // 1 year
-            {"2Y", 2.0},          // 2 years
-            {"3Y", 3.0},          // 3 years
-            {"5Y", 5.0},          // 5 years
-            {"7Y", 7.0},          // 7 years
-            {"10Y", 10.0},        // 10 years
-            {"20Y", 20.0},        // 20 years
-            {"30Y", 30.0}         // 30 years
-        };
+// Second-derivative coefficients of the natural cubic spline through (x, y),
+// from one tridiagonal solve
+inline std::vector<double> calculateSplineCoefficients(const std::vector<double>& x,
+                                                       const std::vector<double>& y) {
+    int n = x.size();
+    std::vector<double> h(n-1), alpha(n-1), mu(n), z(n), c(n);
+
+    for (int i = 0; i < n-1; i++) {
+        h[i] = x[i+1] - x[i];
     }
-    
-    // Helper function for linear interpolation
-    double linearInterpolation(double x, double x1, double y1, double x2, double y2) const {
-        if (std::abs(x2 - x1) < 1e-9) return y1;
-        return y1 + (y2 - y1) * (x - x1) / (x2 - x1);
+
+    for (int i = 1; i < n-1; i++) {
+        alpha[i] = (3.0/h[i]) * (y[i+1] - y[i]) - (3.0/h[i-1]) * (y[i] - y[i-1]);
     }
-    
-    // Cubic spline interpolation for smoother curves
-    std::vector<double> calculateSplineCoefficients(const std::vector<double>& x, 
-                                                   const std::vector<double>& y) const {
-        int n = x.size();
-        std::vector<double> h(n-1), alpha(n-1), mu(n), z(n), c(n);
-        
-        for (int i = 0; i < n-1; i++) {
-            h[i] = x[i+1] - x[i];
+
+    // Natural spline conditions
+    mu[0] = 0;
+    z[0] = 0;
+    c[0] = 0;
+
+    for (int i = 1; i < n-1; i++) {
+        double l = 2 * (x[i+1] - x[i-1]) - h[i-1] * mu[i-1];
+        mu[i] = h[i] / l;
+        z[i] = (alpha[i] - h[i-1] * z[i-1]) / l;
+    }
+
+    c[n-1] = 0;
+    for (int i = n-2; i >= 0; i--) {
+        c[i] = z[i] - mu[i] * c[i+1];
+    }
+
+    return c;
+}
+
+// Index of the segment [knots[i], knots[i+1]] holding t, for t inside the knot
+// range. The loop has a fixed trip count and compiles to cmov.
+inline size_t bracketKnots(const double* knots, size_t n, double t) {
+    const double* base = knots;
+    size_t len = n - 1;
+    while (len > 1) {
+        size_t half = len / 2;
+        base = (base[half] <= t) ? base + half : base;
+        len -= half;
+    }
+    return static_cast<size_t>(base - knots);
+}
+
+enum class InterpolationMode {
+    Linear,       // Piecewise linear between published tenors
+    CubicSpline   // Natural cubic spline through published tenors
+};
+
+// Shape buckets used by analyzeCurveShape
+enum class CurveShape : uint8_t {
+    InsufficientData,
+    Humped,
+    Inverted,
+    SteepNormal,
+    Normal,
+    Flat
+};
+
+inline constexpr size_t kCurveShapeCount = 6;
+
+inline const char* curveShapeLabel(CurveShape shape) {
+    static const char* const labels[kCurveShapeCount] = {
+        "Insufficient Data", "Humped", "Inverted", "Steep Normal", "Normal", "Flat"
+    };
+    return labels[static_cast<size_t>(shape)];
+}
+
+// Immutable evaluation form of a curve, built once after each load: sorted
+// knots plus per-segment polynomial coefficients, so that on segment i
+//   y(t) = values[i] + dx * (slopes[i] + dx * (quadratic[i] + dx * cubic[i]))
+// with dx = t - knots[i]. Linear mode leaves the higher-order terms at zero.
+// Evaluation is a branchless bracket search plus a Horner polynomial, with
+// flat extrapolation at both ends.
+//
+// The curve also caches log(1 + y/100) at every knot. With annual
+// compounding, -log DF(t) = t * log(1 + y(t)/100), so discount factors and
+// forwards at knots or on the flat wings need no logarithm at all.
+class CompiledCurve {
+private:
+    std::vector<double> knots;
+    std::vector<double> values;
+    std::vector<double> slopes;
+    std::vector<double> quadratic;
+    std::vector<double> cubic;
+    std::vector<double> log_growth;
+    InterpolationMode mode = InterpolationMode::Linear;
+
+    void buildSpline() {
+        size_t n = knots.size();
+        std::vector<double> c = calculateSplineCoefficients(knots, values);
+        for (size_t i = 0; i + 1 < n; i++) {
+            double h = knots[i + 1] - knots[i];
+            slopes[i] = (values[i + 1] - values[i]) / h - h * (c[i + 1] + 2.0 * c[i]) / 3.0;
+            quadratic[i] = c[i];
+            cubic[i] = (c[i + 1] - c[i]) / (3.0 * h);
         }
-        
-        for (int i = 1; i < n-1; i++) {
-            alpha[i] = (3.0/h[i]) * (y[i+1] - y[i]) - (3.0/h[i-1]) * (y[i] - y[i-1]);
+    }
+
+public:
+    void build(const std::vector<YieldPoint>& points, InterpolationMode interpolation = InterpolationMode::Linear) {
+        size_t n = points.size();
+        knots.resize(n);
+        values.resize(n);
+        slopes.assign(n, 0.0);
+        quadratic.assign(n, 0.0);
+        cubic.assign(n, 0.0);
+        mode = InterpolationMode::Linear;
+
+        bool distinct_knots = true;
+        for (size_t i = 0; i < n; i++) {
+            knots[i] = points[i].maturity;
+            values[i] = points[i].yield;
         }
-        
-        // Natural spline conditions
-        mu[0] = 0;
-        z[0] = 0;
-        c[0] = 0;
-        
-        for (int i = 1; i < n-1; i++) {
-            double l = 2 * (x[i+1] - x[i-1]) - h[i-1] * mu[i-1];
-            mu[i] = h[i] / l;
-            z[i] = (alpha[i] - h[i-1] * z[i-1]) / l;
+        for (size_t i = 0; i + 1 < n; i++) {
+            double width = knots[i + 1] - knots[i];
+            if (std::abs(width) < 1e-9) {
+                distinct_knots = false;
+            } else {
+                slopes[i] = (values[i + 1] - values[i]) / width;
+            }
         }
-        
-        c[n-1] = 0;
-        for (int i = n-2; i >= 0; i--) {
-            c[i] = z[i] - mu[i] * c[i+1];
+
+        // A spline needs three distinct knots; otherwise stay piecewise linear
+        if (interpolation == InterpolationMode::CubicSpline && n >= 3 && distinct_knots) {
+            buildSpline();
+            mode = InterpolationMode::CubicSpline;
         }
-        
-        return c;
+
+        log_growth.resize(n);
+        for (size_t i = 0; i < n; i++) log_growth[i] = std::log1p(values[i] / 100.0);
     }
 
-public:
-    YieldCurveLive(const std::string& date = "") : curve_date(date) {
-        initializeMaturityMap();
+    size_t size() const { return knots.size(); }
+    InterpolationMode getMode() const { return mode; }
+
+    size_t bracket(double t) const { return bracketKnots(knots.data(), knots.size(), t); }
+
+    double evaluateSegment(size_t i, double t) const {
+        double dx = t - knots[i];
+        if (mode == InterpolationMode::Linear) return values[i] + slopes[i] * dx;
+        return values[i] + dx * (slopes[i] + dx * (quadratic[i] + dx * cubic[i]));
     }
-    
-    // Load yield data from CSV file with expanded Treasury maturities
-    bool loadFromCSV(const std::string& filename, const std::string& date_filter = "") {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << std::endl;
-        return false; // Stop processing if file can't be opened
+
+    double evaluate(double t) const {
+        size_t n = knots.size();
+        if (n == 0) return 0.0;
+        if (t <= knots[0]) return values[0];
+        if (t >= knots[n - 1]) return values[n - 1];
+        return evaluateSegment(bracket(t), t);
     }
 
-    std::string line;
-    if (!std::getline(file, line)) {
-        std::cerr << "Error: CSV file " << filename << " is empty or unreadable." << std::endl;
-        return false; // No header or empty file
+    // Natural log of the discount factor to t. Knot maturities and the flat
+    // wings come straight from the cache; only interior points need a log1p.
+    double logDiscount(double t) const {
+        size_t n = knots.size();
+        if (n == 0) return 0.0;
+        if (t <= knots[0]) return -t * log_growth[0];
+        if (t >= knots[n - 1]) return -t * log_growth[n - 1];
+
+        size_t i = bracket(t);
+        if (t == knots[i]) return -t * log_growth[i];
+        return -t * std::log1p(evaluateSegment(i, t) / 100.0);
     }
 
-    bool found_date = false;
-    while (std::getline(file, line)) {
-        if (line.empty()) {
-            std::cerr << "Warning: Skipping empty line in CSV file." << std::endl;
-            continue; // Skip empty lines gracefully
+    // Evaluate `count` maturities into `out` with the widest SIMD kernel this
+    // build targets. Scalar builds take a single merge pass over the segments
+    // when the inputs are ascending (cash-flow schedules).
+    void evaluateBatch(const double* t, double* out, size_t count) const {
+        if (knots.empty()) {
+            std::fill(out, out + count, 0.0);
+            return;
+        }
+        bool spline = mode == InterpolationMode::CubicSpline;
+#if defined(__AVX512F__)
+        size_t done = spline ? evaluateAvx512<true>(t, out, count) : evaluateAvx512<false>(t, out, count);
+#elif defined(__AVX2__)
+        size_t done = spline ? evaluateAvx2<true>(t, out, count) : evaluateAvx2<false>(t, out, count);
+#else
+        (void)spline;
+        if (std::is_sorted(t, t + count)) {
+            evaluateSorted(t, out, count);
+            return;
         }
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> tokens;
+        size_t done = 0;
+#endif
+        for (size_t i = done; i < count; i++) out[i] = evaluate(t[i]);
+    }
+
+private:
+    void evaluateSorted(const double* t, double* out, size_t count) const {
+        size_t n = knots.size();
+        size_t segment = 0;
+        for (size_t i = 0; i < count; i++) {
+            double x = t[i];
+            if (x <= knots[0]) {
+                out[i] = values[0];
+            } else if (x >= knots[n - 1]) {
+                out[i] = values[n - 1];
+            } else {
+                while (knots[segment + 1] <= x) segment++;
+                out[i] = evaluateSegment(segment, x);
+            }
+        }
+    }
 
-        while (std::getline(iss, token, ',')) {
-            tokens.push_back(token);
+    // SIMD kernels, one lane per query: clamp into the knot range, find the
+    // segment by counting interior knots <= x (curves carry about a dozen
+    // knots, so broadcast compares beat a gathered binary search), then gather
+    // the segment coefficients and finish with FMAs.
+#if defined(__AVX512F__)
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // GCC 12 false positive in avx512fintrin.h
+#endif
+    template <bool Spline>
+    size_t evaluateAvx512(const double* t, double* out, size_t count) const {
+        const size_t n = knots.size();
+        const __m512d lo = _mm512_set1_pd(knots.front());
+        const __m512d hi = _mm512_set1_pd(knots.back());
+        const __m512i one = _mm512_set1_epi64(1);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m512d x = _mm512_min_pd(_mm512_max_pd(_mm512_loadu_pd(t + i), lo), hi);
+            __m512i segment = _mm512_setzero_si512();
+            for (size_t k = 1; k + 1 < n; k++) {
+                __mmask8 below = _mm512_cmp_pd_mask(_mm512_set1_pd(knots[k]), x, _CMP_LE_OQ);
+                segment = _mm512_mask_add_epi64(segment, below, segment, one);
+            }
+            __m512d dx = _mm512_sub_pd(x, _mm512_i64gather_pd(segment, knots.data(), 8));
+            __m512d poly = _mm512_i64gather_pd(segment, slopes.data(), 8);
+            if (Spline) {
+                __m512d c3 = _mm512_i64gather_pd(segment, cubic.data(), 8);
+                __m512d c2 = _mm512_i64gather_pd(segment, quadratic.data(), 8);
+                poly = _mm512_fmadd_pd(dx, _mm512_fmadd_pd(dx, c3, c2), poly);
+            }
+            __m512d value = _mm512_i64gather_pd(segment, values.data(), 8);
+            _mm512_storeu_pd(out + i, _mm512_fmadd_pd(poly, dx, value));
         }
+        return i;
+    }
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#elif defined(__AVX2__)
+    static __m256d fmadd(__m256d a, __m256d b, __m256d c) {
+#if defined(__FMA__)
+        return _mm256_fmadd_pd(a, b, c);
+#else
+        return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+    }
+
+    template <bool Spline>
+    size_t evaluateAvx2(const double* t, double* out, size_t count) const {
+        const size_t n = knots.size();
+        const __m256d lo = _mm256_set1_pd(knots.front());
+        const __m256d hi = _mm256_set1_pd(knots.back());
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256d x = _mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(t + i), lo), hi);
+            __m256i segment = _mm256_setzero_si256();
+            for (size_t k = 1; k + 1 < n; k++) {
+                // Compare masks are all-ones (-1) per lane, so subtracting counts them
+                __m256d below = _mm256_cmp_pd(_mm256_set1_pd(knots[k]), x, _CMP_LE_OQ);
+                segment = _mm256_sub_epi64(segment, _mm256_castpd_si256(below));
+            }
+            __m256d dx = _mm256_sub_pd(x, _mm256_i64gather_pd(knots.data(), segment, 8));
+            __m256d poly = _mm256_i64gather_pd(slopes.data(), segment, 8);
+            if (Spline) {
+                __m256d c3 = _mm256_i64gather_pd(cubic.data(), segment, 8);
+                __m256d c2 = _mm256_i64gather_pd(quadratic.data(), segment, 8);
+                poly = fmadd(dx, fmadd(dx, c3, c2), poly);
+            }
+            __m256d value = _mm256_i64gather_pd(values.data(), segment, 8);
+            _mm256_storeu_pd(out + i, fmadd(poly, dx, value));
+        }
+        return i;
+    }
+#endif
+};
+
+// Forward rates between every pair of grid maturities. Only the upper
+// triangle is stored: row i holds the forwards from grid[i] to grid[i+1..n-1],
+// and rows are packed back to back, so an n-point grid costs n(n-1)/2 values.
+struct ForwardMatrix {
+    std::vector<double> grid;
+    std::vector<double> log_discount;   // log DF at each grid maturity
+    std::vector<double> rates;          // percent, annual compounding
+
+    size_t size() const { return grid.size(); }
+    size_t rowOffset(size_t start) const { return start * grid.size() - start * (start + 1) / 2; }
+    size_t rowLength(size_t start) const { return grid.size() - start - 1; }
+    const double* row(size_t start) const { return rates.data() + rowOffset(start); }
+
+    // Same convention as getForwardRate: non-increasing pairs give 0
+    double at(size_t start, size_t end) const {
+        return start < end ? rates[rowOffset(start) + end - start - 1] : 0.0;
+    }
+};
+
+// Maturities 1/12, 2/12, ... out to `months` months
+inline std::vector<double> monthlyMaturityGrid(size_t months = 360) {
+    std::vector<double> grid(months);
+    for (size_t m = 0; m < months; m++) grid[m] = static_cast<double>(m + 1) / 12.0;
+    return grid;
+}
+
+// One forward matrix row: out[j] = expm1((start_ldf - end_ldf[j]) / (end_t[j] - start_t))
+// in percent. SIMD builds evaluate expm1 with a Cody-Waite reduction
+// x = k ln2 + r and a degree-13 polynomial for expm1(r), recombined as
+// 2^k expm1(r) + (2^k - 1) so small forwards keep full relative precision.
+// Results agree with std::expm1 to within a couple of ulps.
+namespace forward_kernel_detail {
+
+inline constexpr double kLn2Hi = 6.93147180369123816490e-01;
+inline constexpr double kLn2Lo = 1.90821492927058770002e-10;
+inline constexpr double kInvLn2 = 1.44269504088896338700e+00;
+inline constexpr double kMaxExponent = 700.0;
+// 1/m! for m = 13 down to 2
+inline constexpr double kExpm1Coefficients[] = {
+    1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+    1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0,
+    1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5
+};
+
+#if defined(__AVX512F__)
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // GCC 12 false positive in avx512fintrin.h
+#endif
+inline __m512d expm1Avx512(__m512d x) {
+    x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(-kMaxExponent)), _mm512_set1_pd(kMaxExponent));
+    __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(kInvLn2)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kLn2Hi), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(kLn2Lo), r);
+
+    __m512d p = _mm512_set1_pd(kExpm1Coefficients[0]);
+    for (size_t c = 1; c < sizeof(kExpm1Coefficients) / sizeof(double); c++) {
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(kExpm1Coefficients[c]));
+    }
+    __m512d one = _mm512_set1_pd(1.0);
+    __m512d q = _mm512_mul_pd(_mm512_fmadd_pd(p, r, one), r);   // expm1(r)
+    __m512d scale = _mm512_scalef_pd(one, k);                    // 2^k
+    return _mm512_fmadd_pd(scale, q, _mm512_sub_pd(scale, one));
+}
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+#elif defined(__AVX2__)
+inline __m256d fmadd(__m256d a, __m256d b, __m256d c) {
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+inline __m256d expm1Avx2(__m256d x) {
+    x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-kMaxExponent)), _mm256_set1_pd(kMaxExponent));
+    __m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(kInvLn2)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(kLn2Hi)));
+    r = _mm256_sub_pd(r, _mm256_mul_pd(k, _mm256_set1_pd(kLn2Lo)));
+
+    __m256d p = _mm256_set1_pd(kExpm1Coefficients[0]);
+    for (size_t c = 1; c < sizeof(kExpm1Coefficients) / sizeof(double); c++) {
+        p = fmadd(p, r, _mm256_set1_pd(kExpm1Coefficients[c]));
+    }
+    __m256d one = _mm256_set1_pd(1.0);
+    __m256d q = _mm256_mul_pd(fmadd(p, r, one), r);
+
+    // 2^k straight into the exponent field; |k| <= 1010 so it stays normal
+    __m256i biased = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(k)), _mm256_set1_epi64x(1023));
+    __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(biased, 52));
+    return fmadd(scale, q, _mm256_sub_pd(scale, one));
+}
+#endif
+
+} // namespace forward_kernel_detail
+
+inline void forwardRow(double start_t, double start_ldf, const double* end_t, const double* end_ldf,
+                       double* out, size_t count) {
+    size_t j = 0;
+#if defined(__AVX512F__)
+    const __m512d t0 = _mm512_set1_pd(start_t);
+    const __m512d l0 = _mm512_set1_pd(start_ldf);
+    const __m512d percent = _mm512_set1_pd(100.0);
+    for (; j + 8 <= count; j += 8) {
+        __m512d x = _mm512_div_pd(_mm512_sub_pd(l0, _mm512_loadu_pd(end_ldf + j)),
+                                  _mm512_sub_pd(_mm512_loadu_pd(end_t + j), t0));
+        _mm512_storeu_pd(out + j, _mm512_mul_pd(forward_kernel_detail::expm1Avx512(x), percent));
+    }
+#elif defined(__AVX2__)
+    const __m256d t0 = _mm256_set1_pd(start_t);
+    const __m256d l0 = _mm256_set1_pd(start_ldf);
+    const __m256d percent = _mm256_set1_pd(100.0);
+    for (; j + 4 <= count; j += 4) {
+        __m256d x = _mm256_div_pd(_mm256_sub_pd(l0, _mm256_loadu_pd(end_ldf + j)),
+                                  _mm256_sub_pd(_mm256_loadu_pd(end_t + j), t0));
+        _mm256_storeu_pd(out + j, _mm256_mul_pd(forward_kernel_detail::expm1Avx2(x), percent));
+    }
+#endif
+    for (; j < count; j++) {
+        out[j] = std::expm1((start_ldf - end_ldf[j]) / (end_t[j] - start_t)) * 100.0;
+    }
+}
+
+class YieldCurveLive {
+private:
+    std::vector<YieldPoint> yield_points;
+    CompiledCurve compiled;
+    InterpolationMode interpolation = InterpolationMode::Linear;
+    std::string curve_date;
 
-        if (tokens.size() < 12) {
-            std::cerr << "Warning: Skipping line with insufficient columns (expected 12): " << line << std::endl;
-            continue; // Skip malformed lines without enough columns
+    // Parse one CSV row laid out as `columns` into this curve. Returns true if
+    // any tenor had data. Columns were resolved from the header, so there is
+    // no label lookup per row.
+    bool parseCurveRow(std::string_view line, const CsvColumnMap& columns, CsvFields& tokens) {
+        if (line.empty()) {
+            std::cerr << "Warning: Skipping empty line in CSV file." << std::endl;
+            return false; // Skip empty lines gracefully
         }
 
-        std::string date = tokens[0];
+        splitCsvFields(line, tokens);
+        if (tokens.size() < columns.min_fields) {
+            std::cerr << "Warning: Skipping line with insufficient columns (expected " << columns.min_fields
+                      << "): " << line << std::endl;
+            return false; // Skip malformed lines without enough columns
+        }
 
-        if (!date_filter.empty() && date.find(date_filter) == std::string::npos) {
-            continue; // Skip lines not matching date filter early
+        std::string_view date = tokens[kCsvDateColumn];
+        int32_t day;
+        if (!parseIsoDate(date, day)) {
+            std::cerr << "Warning: Skipping line with invalid date '" << date << "'" << std::endl;
+            return false;
         }
 
         // Clear previous data before new date load
         yield_points.clear();
-        curve_date = date;
-
-        std::vector<std::string> maturity_order = {
-            "1MO", "3MO", "6MO", "1Y", "2Y", "3Y", "5Y", "7Y", "10Y", "20Y", "30Y"
-        };
+        curve_date.assign(date.data(), date.size());
 
         bool valid_data_found = false;
-        for (size_t i = 0; i < maturity_order.size() && i + 1 < tokens.size(); i++) {
-            std::string mat_label = maturity_order[i];
-
-            try {
-                if (tokens[i + 1].empty()) {
-                    std::cerr << "Warning: Missing yield value for " << mat_label << " on date " << date << std::endl;
-                    continue; // Skip missing yield values
-                }
-                double yield_val = std::stod(tokens[i + 1]);
-                double maturity_years = maturity_map.at(mat_label);
-                yield_points.emplace_back(maturity_years, yield_val, mat_label);
-                valid_data_found = true;
-            } catch (const std::invalid_argument&) {
-                std::cerr << "Warning: Invalid yield data '" << tokens[i + 1] << "' for " << mat_label 
+        for (const auto& column : columns.tenors) {
+            const char* mat_label = kHistoryTenorLabels[column.tenor];
+            std::string_view field = tokens[column.field];
+
+            double yield_val = 0.0;
+            CsvValueStatus status = parseCsvValue(field, yield_val);
+            if (status == CsvValueStatus::Missing || status == CsvValueStatus::NoData) {
+                std::cerr << "Warning: Missing yield value for " << mat_label << " on date " << date << std::endl;
+                continue; // Skip missing yield values
+            }
+            if (status == CsvValueStatus::Invalid) {
+                std::cerr << "Warning: Invalid yield data '" << field << "' for " << mat_label
                           << " on date " << date << std::endl;
                 continue;
-            } catch (const std::out_of_range&) {
-                std::cerr << "Warning: Yield data out of range for " << mat_label << std::endl;
-                continue;
             }
-        }
 
-        if (valid_data_found) {
-            found_date = true;
-            if (!date_filter.empty()) break; // Stop if filtered date found and loaded
+            yield_points.emplace_back(kHistoryTenorYears[column.tenor], yield_val, column.tenor);
+            valid_data_found = true;
         }
+        return valid_data_found;
     }
 
-    if (!found_date) {
-        std::cerr << "Warning: No valid data found in CSV for date filter '" << date_filter << "'." << std::endl;
-    }
+public:
+    YieldCurveLive(const std::string& date = "") : curve_date(date) {}
+    
+    // Load yield data from CSV file with expanded Treasury maturities.
+    // The file is memory-mapped and tokenized in place. Rows are assumed to be
+    // in date order: the latest curve is read from the end of the file and a
+    // date filter ("2024-03-15", "2024-03", "2024-Q3", ...) bisects straight to
+    // its first matching row, so neither case scans the whole history. Tenor
+    // columns are found by header label, through maturity_mapping_live.json
+    // next to the file when there is one.
+    bool loadFromCSV(const std::string& filename, const std::string& date_filter = "") {
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false; // Stop processing if file can't be opened
+        }
 
-    if (!yield_points.empty()) {
-        std::sort(yield_points.begin(), yield_points.end(), 
-                  [](const YieldPoint& a, const YieldPoint& b) {
-                      return a.maturity < b.maturity;
-                  });
-    } else {
-        std::cerr << "Error: No yield points loaded. Please check the CSV file content." << std::endl;
-    }
+        CsvLineReader header_reader(file.view());
+        std::string_view line;
+        if (!header_reader.next(line)) {
+            std::cerr << "Error: CSV file " << filename << " is empty or unreadable." << std::endl;
+            return false; // No header or empty file
+        }
+        std::string_view body = file.view().substr(header_reader.offset());
 
-    file.close();
-    return found_date;
-}
+        CsvColumnMap columns;
+        if (!resolveCsvColumns(filename, line, "", columns)) return false;
 
-    
-    // Get interpolated yield for any maturity using improved method
-    double getYield(double maturity) const {
-        if (yield_points.empty()) return 0.0;
-        
-        // If exact match
-        for (const auto& point : yield_points) {
-            if (std::abs(point.maturity - maturity) < 1e-6) {
-                return point.yield;
+        CsvFields tokens;
+        bool found_date = false;
+        if (date_filter.empty()) {
+            CsvReverseLineReader reader(body);
+            while (!found_date && reader.previous(line)) {
+                found_date = parseCurveRow(line, columns, tokens);
+            }
+        } else {
+            DateRange range;
+            if (!parseDateQuery(date_filter, range)) {
+                std::cerr << "Error: Invalid date filter '" << date_filter
+                          << "' (expected YYYY-MM-DD, YYYY-MM, YYYY or YYYY-Qn)." << std::endl;
+                return false;
+            }
+
+            CsvLineReader reader(body.substr(lowerBoundRowOffset(body, range.first)));
+            while (!found_date && reader.next(line)) {
+                int32_t day;
+                if (csvLineDay(line, 0, day) && day > range.last) break; // Past the requested range
+                found_date = parseCurveRow(line, columns, tokens);
             }
         }
-        
-        // Handle boundary cases
-        if (maturity <= yield_points.front().maturity) {
-            return yield_points.front().yield;
+
+        if (!found_date) {
+            std::cerr << "Warning: No valid data found in CSV for date filter '" << date_filter << "'." << std::endl;
         }
-        
-        if (maturity >= yield_points.back().maturity) {
-            return yield_points.back().yield;
+
+        if (!yield_points.empty()) {
+            std::sort(yield_points.begin(), yield_points.end(),
+                      [](const YieldPoint& a, const YieldPoint& b) {
+                          return a.maturity < b.maturity;
+                      });
+        } else {
+            std::cerr << "Error: No yield points loaded. Please check the CSV file content." << std::endl;
         }
-        
-        // Linear interpolation between surrounding points
-        for (size_t i = 0; i < yield_points.size() - 1; i++) {
-            if (yield_points[i].maturity <= maturity && 
-                yield_points[i+1].maturity >= maturity) {
-                return linearInterpolation(maturity, 
-                                         yield_points[i].maturity, yield_points[i].yield,
-                                         yield_points[i+1].maturity, yield_points[i+1].yield);
-            }
+
+        compiled.build(yield_points, interpolation);
+        return found_date;
+    }
+
+    // Point this curve at one row of an already-parsed history. This only
+    // copies the row's tenors, so switching dates never touches the file.
+    bool loadFromHistory(const CurveHistory& history, size_t row) {
+        if (row >= history.size()) return false;
+
+        yield_points.clear();
+        curve_date = history.getDate(row);
+
+        for (size_t i = 0; i < kHistoryTenorCount; i++) {
+            double yield_val = history.getYield(row, i);
+            if (std::isnan(yield_val)) continue; // Tenor not published that day
+            yield_points.emplace_back(kHistoryTenorYears[i], yield_val, static_cast<TenorId>(i));
         }
-        
-        return 0.0;
+        compiled.build(yield_points, interpolation);
+        return !yield_points.empty();
+    }
+
+    // Get interpolated yield for any maturity from the compiled curve
+    double getYield(double maturity) const {
+        return compiled.evaluate(maturity);
+    }
+    
+    // Switch interpolation scheme; spline coefficients are solved here once,
+    // not per query
+    void setInterpolationMode(InterpolationMode mode) {
+        interpolation = mode;
+        compiled.build(yield_points, interpolation);
+    }
+    InterpolationMode getInterpolationMode() const { return compiled.getMode(); }
+
+    // Interpolated yields for many maturities in one call. `yields` must have
+    // room for `count` values and must not overlap `maturities`.
+    void getYields(const double* maturities, double* yields, size_t count) const {
+        compiled.evaluateBatch(maturities, yields, count);
+    }
+
+    std::vector<double> getYields(const std::vector<double>& maturities) const {
+        std::vector<double> yields(maturities.size());
+        getYields(maturities.data(), yields.data(), maturities.size());
+        return yields;
     }
     
-    // Calculate forward rates with improved precision
+    // Annual-compounded forward rate between two maturities, from cached
+    // log discount factors: one subtraction and one exp per query
     double getForwardRate(double start_maturity, double end_maturity) const {
         if (end_maturity <= start_maturity) return 0.0;
-        
-        double y1 = getYield(start_maturity) / 100.0; // Convert to decimal
-        double y2 = getYield(end_maturity) / 100.0;
-        
-        try {
-            double forward_rate = std::pow((std::pow(1 + y2, end_maturity) / 
-                                           std::pow(1 + y1, start_maturity)), 
-                                          1.0 / (end_maturity - start_maturity)) - 1.0;
-            
-            return forward_rate * 100.0; // Convert back to percentage
-        } catch (const std::exception& e) {
-            return 0.0; // Return 0 on calculation error
+
+        double log_ratio = compiled.logDiscount(start_maturity) - compiled.logDiscount(end_maturity);
+        return std::expm1(log_ratio / (end_maturity - start_maturity)) * 100.0; // Convert back to percentage
+    }
+
+    // Discount factor to `maturity` implied by the annual-compounded curve
+    double getDiscountFactor(double maturity) const {
+        return std::exp(compiled.logDiscount(maturity));
+    }
+
+    // Forward rate for every start < end pair of `grid`, into a caller-owned
+    // matrix so repeated calls (one per historical date) reuse its buffers.
+    // The grid is sorted and de-duplicated first. Log discount factors are
+    // taken once per grid point; each matrix row is then a vectorized pass.
+    void forwardMatrix(const std::vector<double>& grid, ForwardMatrix& matrix) const {
+        if (&matrix.grid != &grid) matrix.grid = grid;
+        std::sort(matrix.grid.begin(), matrix.grid.end());
+        matrix.grid.erase(std::unique(matrix.grid.begin(), matrix.grid.end()), matrix.grid.end());
+
+        size_t n = matrix.grid.size();
+        matrix.log_discount.resize(n);
+        for (size_t i = 0; i < n; i++) matrix.log_discount[i] = compiled.logDiscount(matrix.grid[i]);
+
+        matrix.rates.resize(n > 1 ? n * (n - 1) / 2 : 0);
+        for (size_t i = 0; i + 1 < n; i++) {
+            forwardRow(matrix.grid[i], matrix.log_discount[i], &matrix.grid[i + 1], &matrix.log_discount[i + 1],
+                       matrix.rates.data() + matrix.rowOffset(i), matrix.rowLength(i));
         }
     }
+
+    ForwardMatrix forwardMatrix(const std::vector<double>& grid) const {
+        ForwardMatrix matrix;
+        forwardMatrix(grid, matrix);
+        return matrix;
+    }
     
     // Calculate modified duration
     double getDuration(double maturity, double coupon_rate = 0.0) const {
@@ -250,26 +669,31 @@ public:
         return getYield(maturity2) - getYield(maturity1);
     }
     
-    // Analyze curve shape with detailed classification
-    std::string analyzeCurveShape() const {
-        if (yield_points.size() < 3) return "Insufficient Data";
+    // Classify curve shape from the 3M, 5Y and 30Y points
+    CurveShape classifyCurveShape() const {
+        if (yield_points.size() < 3) return CurveShape::InsufficientData;
         
         double short_rate = getYield(0.25);
         double medium_rate = getYield(5.0);
         double long_rate = getYield(30.0);
         
         if (short_rate > medium_rate + 0.2 && long_rate > medium_rate + 0.2) {
-            return "Humped";
+            return CurveShape::Humped;
         } else if (short_rate > long_rate + 0.1) {
-            return "Inverted";
+            return CurveShape::Inverted;
         } else if (long_rate > short_rate + 0.5) {
-            return "Steep Normal";
+            return CurveShape::SteepNormal;
         } else if (long_rate > short_rate + 0.1) {
-            return "Normal";
+            return CurveShape::Normal;
         } else {
-            return "Flat";
+            return CurveShape::Flat;
         }
     }
+
+    // Analyze curve shape with detailed classification
+    std::string analyzeCurveShape() const {
+        return curveShapeLabel(classifyCurveShape());
+    }
     
     // Print comprehensive yield curve analysis
     void printCurve() const {
@@ -287,7 +711,7 @@ public:
             double duration = getDuration(point.maturity);
             double dv01 = duration * 100; // Approximate DV01 for $10,000 face value
             
-            std::cout << std::setw(10) << point.maturity_label 
+            std::cout << std::setw(10) << point.label()
                       << std::setw(12) << std::fixed << std::setprecision(2) << point.yield
                       << std::setw(15) << std::setprecision(2) << duration
                       << std::setw(12) << std::setprecision(0) << dv01
@@ -323,6 +747,56 @@ public:
                   << " bps (Term Premium)" << std::endl;
     }
     
+    // Dashboard JSON document with enhanced metrics
+    void writeJSON(JsonWriter& json) const {
+        json.beginObject();
+        json.key("data_source").string("Federal Reserve H.15 Selected Interest Rates");
+        json.key("source_url").string("https://www.federalreserve.gov/releases/h15/");
+        json.key("date").string(curve_date);
+        json.key("curve_shape").string(curveShapeLabel(classifyCurveShape()));
+
+        json.key("yield_points").beginArray();
+        for (const auto& point : yield_points) {
+            json.beginObject();
+            json.key("maturity_label").string(point.label());
+            json.key("maturity_years").number(point.maturity);
+            json.key("yield").number(point.yield);
+            json.key("duration").number(getDuration(point.maturity));
+            json.endObject();
+        }
+        json.endArray();
+
+        json.key("key_spreads").beginObject();
+        json.key("2s10s_bps").number(getSpread(2.0, 10.0) * 100);
+        json.key("3m10y_bps").number(getSpread(0.25, 10.0) * 100);
+        json.key("5s30s_bps").number(getSpread(5.0, 30.0) * 100);
+        json.key("1m3m_bps").number(getSpread(1.0/12.0, 0.25) * 100);
+        json.endObject();
+
+        json.key("forward_rates").beginObject();
+        json.key("1y1y").number(getForwardRate(1.0, 2.0));
+        json.key("2y1y").number(getForwardRate(2.0, 3.0));
+        json.key("5y5y").number(getForwardRate(5.0, 10.0));
+        json.key("10y10y").number(getForwardRate(10.0, 20.0));
+        json.endObject();
+
+        double recession_spread = getSpread(2.0, 10.0);
+        json.key("economic_indicators").beginObject();
+        json.key("recession_warning").boolean(recession_spread < -0.2);
+        json.key("term_premium_bps").number(getSpread(10.0, 30.0) * 100);
+        json.key("curve_steepness").string(recession_spread > 1.0 ? "steep" :
+                                           recession_spread < -0.1 ? "inverted" : "flat");
+        json.endObject();
+
+        json.endObject();
+        json.raw("\n");
+    }
+
+    void writeJSON(std::ostream& out) const {
+        JsonWriter json(out);
+        writeJSON(json);
+    }
+
     // Export curve data for dashboard with enhanced metrics
     void exportToJSON(const std::string& filename) const {
         std::ofstream file(filename);
@@ -331,49 +805,9 @@ public:
             return;
         }
         
-        file << "{\\n";
-        file << "  \"data_source\": \"Federal Reserve H.15 Selected Interest Rates\",\\n";
-        file << "  \"source_url\": \"https://www.federalreserve.gov/releases/h15/\",\\n";
-        file << "  \"date\": \"" << curve_date << "\",\\n";
-        file << "  \"curve_shape\": \"" << analyzeCurveShape() << "\",\\n";
-        file << "  \"yield_points\": [\\n";
-        
-        for (size_t i = 0; i < yield_points.size(); i++) {
-            const auto& point = yield_points[i];
-            file << "    {\\n";
-            file << "      \"maturity_label\": \"" << point.maturity_label << "\",\\n";
-            file << "      \"maturity_years\": " << point.maturity << ",\\n";
-            file << "      \"yield\": " << point.yield << ",\\n";
-            file << "      \"duration\": " << getDuration(point.maturity) << "\\n";
-            file << "    }";
-            if (i < yield_points.size() - 1) file << ",";
-            file << "\\n";
-        }
-        
-        file << "  ],\\n";
-        file << "  \"key_spreads\": {\\n";
-        file << "    \"2s10s_bps\": " << getSpread(2.0, 10.0) * 100 << ",\\n";
-        file << "    \"3m10y_bps\": " << getSpread(0.25, 10.0) * 100 << ",\\n";
-        file << "    \"5s30s_bps\": " << getSpread(5.0, 30.0) * 100 << ",\\n";
-        file << "    \"1m3m_bps\": " << getSpread(1.0/12.0, 0.25) * 100 << "\\n";
-        file << "  },\\n";
-        file << "  \"forward_rates\": {\\n";
-        file << "    \"1y1y\": " << getForwardRate(1.0, 2.0) << ",\\n";
-        file << "    \"2y1y\": " << getForwardRate(2.0, 3.0) << ",\\n";
-        file << "    \"5y5y\": " << getForwardRate(5.0, 10.0) << ",\\n";
-        file << "    \"10y10y\": " << getForwardRate(10.0, 20.0) << "\\n";
-        file << "  },\\n";
-        file << "  \"economic_indicators\": {\\n";
-        double recession_spread = getSpread(2.0, 10.0);
-        file << "    \"recession_warning\": " << (recession_spread < -0.2 ? "true" : "false") << ",\\n";
-        file << "    \"term_premium_bps\": " << getSpread(10.0, 30.0) * 100 << ",\\n";
-        file << "    \"curve_steepness\": \"" << (recession_spread > 1.0 ? "steep" : 
-                                                    recession_spread < -0.1 ? "inverted" : "flat") << "\"\\n";
-        file << "  }\\n";
-        file << "}\\n";
-        
+        writeJSON(file);
         file.close();
-        std::cout << "\\n💾 Live yield curve data exported to " << filename << std::endl;
+        std::cout << "\n💾 Live yield curve data exported to " << filename << std::endl;
         std::cout << "🌐 Ready for web dashboard integration!" << std::endl;
     }
     
@@ -0,0 +1,288 @@
+#ifndef YIELDCURVE_POLICIES_H
+#define YIELDCURVE_POLICIES_H
+
+#include <cmath>
+#include <vector>
+
+#include "YieldCurveLive.h"
+
+// Compile-time interpolation and extrapolation policies for BasicYieldCurve.
+// Each policy is a plain struct whose methods inline into getYield, so the
+// evaluation hot path has no virtual calls and no runtime mode switch.
+//
+// Interpolation policies implement
+//   void build(const std::vector<double>& knots, const std::vector<double>& yields);
+//   double evaluate(size_t segment, double t) const;   // knots[segment] <= t <= knots[segment + 1]
+// and extrapolation policies implement
+//   static double left(const std::vector<double>& knots, const std::vector<double>& yields, double t);
+//   static double right(const std::vector<double>& knots, const std::vector<double>& yields, double t);
+//
+// Yields are annual-compounded percentages, matching getForwardRate.
+
+namespace curve_policy_detail {
+
+// Continuously compounded rate for an annual-compounded percentage yield
+inline double toContinuous(double yield_pct) { return std::log1p(yield_pct / 100.0); }
+inline double fromContinuous(double rate) { return std::expm1(rate) * 100.0; }
+
+} // namespace curve_policy_detail
+
+// Piecewise linear in yield
+struct LinearInterpolation {
+    std::vector<double> knots;
+    std::vector<double> values;
+    std::vector<double> slopes;
+
+    void build(const std::vector<double>& t, const std::vector<double>& y) {
+        knots = t;
+        values = y;
+        slopes.assign(t.size(), 0.0);
+        for (size_t i = 0; i + 1 < t.size(); i++) {
+            double width = t[i + 1] - t[i];
+            if (std::abs(width) > 1e-9) slopes[i] = (y[i + 1] - y[i]) / width;
+        }
+    }
+
+    double evaluate(size_t i, double t) const {
+        return values[i] + slopes[i] * (t - knots[i]);
+    }
+};
+
+// Linear in log discount factor, i.e. piecewise flat instantaneous forwards
+struct LogLinearDiscountInterpolation {
+    std::vector<double> knots;
+    std::vector<double> log_discount;
+    std::vector<double> slopes;
+
+    void build(const std::vector<double>& t, const std::vector<double>& y) {
+        knots = t;
+        log_discount.resize(t.size());
+        slopes.assign(t.size(), 0.0);
+        for (size_t i = 0; i < t.size(); i++) {
+            log_discount[i] = -t[i] * curve_policy_detail::toContinuous(y[i]);
+        }
+        for (size_t i = 0; i + 1 < t.size(); i++) {
+            double width = t[i + 1] - t[i];
+            if (std::abs(width) > 1e-9) slopes[i] = (log_discount[i + 1] - log_discount[i]) / width;
+        }
+    }
+
+    double evaluate(size_t i, double t) const {
+        double ln_df = log_discount[i] + slopes[i] * (t - knots[i]);
+        return curve_policy_detail::fromContinuous(-ln_df / t);
+    }
+};
+
+// Natural cubic spline in yield, coefficients solved once in build()
+struct CubicSplineInterpolation {
+    std::vector<double> knots;
+    std::vector<double> values;
+    std::vector<double> b;
+    std::vector<double> c;
+    std::vector<double> d;
+
+    void build(const std::vector<double>& t, const std::vector<double>& y) {
+        size_t n = t.size();
+        knots = t;
+        values = y;
+        b.assign(n, 0.0);
+        d.assign(n, 0.0);
+        c = n >= 3 ? calculateSplineCoefficients(t, y) : std::vector<double>(n, 0.0);
+        for (size_t i = 0; i + 1 < n; i++) {
+            double h = t[i + 1] - t[i];
+            if (std::abs(h) < 1e-9) continue;
+            b[i] = (y[i + 1] - y[i]) / h - h * (c[i + 1] + 2.0 * c[i]) / 3.0;
+            d[i] = (c[i + 1] - c[i]) / (3.0 * h);
+        }
+    }
+
+    double evaluate(size_t i, double t) const {
+        double dx = t - knots[i];
+        return values[i] + dx * (b[i] + dx * (c[i] + dx * d[i]));
+    }
+};
+
+// Hagan-West monotone convex method: builds instantaneous forwards that are
+// continuous and stay within the discrete forwards' bounds, then integrates
+// them back to zero rates. Works in continuously compounded rates with an
+// implicit knot at t = 0.
+struct MonotoneConvexInterpolation {
+    std::vector<double> terms;        // 0 followed by the curve knots
+    std::vector<double> rate_terms;   // r(t) * t at each term
+    std::vector<double> discrete;     // discrete forward on (terms[i-1], terms[i]]
+    std::vector<double> g0;           // f(terms[i-1]) - discrete[i]
+    std::vector<double> g1;           // f(terms[i])   - discrete[i]
+
+    void build(const std::vector<double>& t, const std::vector<double>& y) {
+        size_t n = t.size();
+        terms.assign(n + 1, 0.0);
+        rate_terms.assign(n + 1, 0.0);
+        discrete.assign(n + 1, 0.0);
+        g0.assign(n + 1, 0.0);
+        g1.assign(n + 1, 0.0);
+        if (n == 0) return;
+
+        for (size_t i = 0; i < n; i++) {
+            terms[i + 1] = t[i];
+            rate_terms[i + 1] = t[i] * curve_policy_detail::toContinuous(y[i]);
+        }
+        for (size_t i = 1; i <= n; i++) {
+            double width = terms[i] - terms[i - 1];
+            discrete[i] = width > 1e-9 ? (rate_terms[i] - rate_terms[i - 1]) / width : discrete[i - 1];
+        }
+
+        // Instantaneous forwards at the terms
+        std::vector<double> f(n + 1);
+        for (size_t i = 1; i < n; i++) {
+            double span = terms[i + 1] - terms[i - 1];
+            f[i] = ((terms[i] - terms[i - 1]) * discrete[i + 1] + (terms[i + 1] - terms[i]) * discrete[i]) / span;
+        }
+        if (n == 1) {
+            f[0] = f[1] = discrete[1];
+        } else {
+            f[0] = discrete[1] - 0.5 * (f[1] - discrete[1]);
+            f[n] = discrete[n] - 0.5 * (f[n - 1] - discrete[n]);
+        }
+
+        for (size_t i = 1; i <= n; i++) {
+            g0[i] = f[i - 1] - discrete[i];
+            g1[i] = f[i] - discrete[i];
+        }
+    }
+
+    // Integral over [0, x] of the forward adjustment g on a unit interval
+    static double integrateAdjustment(double a, double b, double x) {
+        if (a == 0.0 && b == 0.0) return 0.0;
+
+        if ((a < 0.0 && -0.5 * a <= b && b <= -2.0 * a) ||
+            (a > 0.0 && -0.5 * a >= b && b >= -2.0 * a)) {
+            // Quadratic region
+            return a * (x - 2.0 * x * x + x * x * x) + b * (-x * x + x * x * x);
+        }
+
+        if ((a < 0.0 && b > -2.0 * a) || (a > 0.0 && b < -2.0 * a)) {
+            // Flat near the left end, quadratic rise to the right
+            double eta = (b + 2.0 * a) / (b - a);
+            if (x <= eta) return a * x;
+            double u = x - eta;
+            return a * x + (b - a) * u * u * u / (3.0 * (1.0 - eta) * (1.0 - eta));
+        }
+
+        if ((a > 0.0 && 0.0 > b && b > -0.5 * a) || (a < 0.0 && 0.0 < b && b < -0.5 * a)) {
+            // Quadratic decay from the left end, flat to the right
+            double eta = 3.0 * b / (b - a);
+            if (x >= eta) return b * x + (a - b) * eta / 3.0;
+            double u = eta - x;
+            return b * x + (a - b) * (eta - u * u * u / (eta * eta)) / 3.0;
+        }
+
+        // Same-sign ends: two quadratics meeting at a minimum/maximum A
+        double eta = b / (b + a);
+        double level = -a * b / (a + b);
+        if (x < eta) {
+            double u = eta - x;
+            return level * x + (a - level) * (eta - u * u * u / (eta * eta)) / 3.0;
+        }
+        double result = level * x + (a - level) * eta / 3.0;
+        if (eta < 1.0) {
+            double u = x - eta;
+            result += (b - level) * u * u * u / (3.0 * (1.0 - eta) * (1.0 - eta));
+        }
+        return result;
+    }
+
+    double evaluate(size_t i, double t) const {
+        // Curve segment i spans terms[i + 1] .. terms[i + 2]
+        size_t k = i + 2;
+        double width = terms[k] - terms[k - 1];
+        double x = (t - terms[k - 1]) / width;
+        double rate_term = rate_terms[k - 1] + discrete[k] * (t - terms[k - 1]) +
+                           width * integrateAdjustment(g0[k], g1[k], x);
+        return curve_policy_detail::fromContinuous(rate_term / t);
+    }
+};
+
+// Hold the end yields beyond the knot range
+struct FlatExtrapolation {
+    static double left(const std::vector<double>&, const std::vector<double>& y, double) {
+        return y.front();
+    }
+    static double right(const std::vector<double>&, const std::vector<double>& y, double) {
+        return y.back();
+    }
+};
+
+// Continue the first and last segments' slopes beyond the knot range
+struct LinearExtrapolation {
+    static double left(const std::vector<double>& k, const std::vector<double>& y, double t) {
+        if (k.size() < 2) return y.front();
+        return y[0] + (y[1] - y[0]) / (k[1] - k[0]) * (t - k[0]);
+    }
+    static double right(const std::vector<double>& k, const std::vector<double>& y, double t) {
+        size_t n = k.size();
+        if (n < 2) return y.back();
+        return y[n - 1] + (y[n - 1] - y[n - 2]) / (k[n - 1] - k[n - 2]) * (t - k[n - 1]);
+    }
+};
+
+// Yield curve with interpolation fixed at compile time. Build it from any
+// loaded YieldCurveLive (or its points) once, then evaluate freely.
+template <class InterpPolicy, class ExtrapPolicy = FlatExtrapolation>
+class BasicYieldCurve {
+private:
+    std::vector<double> knots;
+    std::vector<double> yields;
+    InterpPolicy interpolation;
+
+public:
+    BasicYieldCurve() = default;
+    explicit BasicYieldCurve(const std::vector<YieldPoint>& points) { build(points); }
+    explicit BasicYieldCurve(const YieldCurveLive& curve) { build(curve.getYieldPoints()); }
+
+    // Points must be sorted by maturity, as YieldCurveLive keeps them
+    void build(const std::vector<YieldPoint>& points) {
+        knots.resize(points.size());
+        yields.resize(points.size());
+        for (size_t i = 0; i < points.size(); i++) {
+            knots[i] = points[i].maturity;
+            yields[i] = points[i].yield;
+        }
+        interpolation.build(knots, yields);
+    }
+
+    double getYield(double maturity) const {
+        size_t n = knots.size();
+        if (n == 0) return 0.0;
+        if (maturity <= knots.front()) return ExtrapPolicy::left(knots, yields, maturity);
+        if (maturity >= knots.back()) return ExtrapPolicy::right(knots, yields, maturity);
+        return interpolation.evaluate(bracketKnots(knots.data(), n, maturity), maturity);
+    }
+
+    void getYields(const double* maturities, double* out, size_t count) const {
+        for (size_t i = 0; i < count; i++) out[i] = getYield(maturities[i]);
+    }
+
+    double getForwardRate(double start_maturity, double end_maturity) const {
+        if (end_maturity <= start_maturity) return 0.0;
+
+        double y1 = getYield(start_maturity) / 100.0;
+        double y2 = getYield(end_maturity) / 100.0;
+        double forward_rate = std::pow((std::pow(1 + y2, end_maturity) /
+                                       std::pow(1 + y1, start_maturity)),
+                                      1.0 / (end_maturity - start_maturity)) - 1.0;
+        return forward_rate * 100.0;
+    }
+
+    double getSpread(double maturity1, double maturity2) const {
+        return getYield(maturity2) - getYield(maturity1);
+    }
+
+    size_t size() const { return knots.size(); }
+};
+
+using LinearYieldCurve = BasicYieldCurve<LinearInterpolation, FlatExtrapolation>;
+using LogLinearDiscountYieldCurve = BasicYieldCurve<LogLinearDiscountInterpolation, FlatExtrapolation>;
+using CubicSplineYieldCurve = BasicYieldCurve<CubicSplineInterpolation, FlatExtrapolation>;
+using MonotoneConvexYieldCurve = BasicYieldCurve<MonotoneConvexInterpolation, FlatExtrapolation>;
+
+#endif // YIELDCURVE_POLICIES_H
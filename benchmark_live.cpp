@@ -0,0 +1,1081 @@
+#include "YieldCurveLive.h"
+#include "YieldCurvePolicies.h"
+#include "AnalysisColumns.h"
+#include "DashboardServer.h"
+#include "ForwardMatrixExport.h"
+#include "HistoryAnalytics.h"
+#include "HistoryExport.h"
+#include "QueryServer.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Micro-benchmarks for the live analyzer's hot paths. Run from the project
+// root so treasury_yields_live.csv can be found:
+//
+//   ./yield_benchmark_live [csv_file] [scale]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Writes the data rows of `source` `scale` times into `target`, keeping the
+// header once, so loaders see a realistic long history.
+size_t writeScaledCSV(const std::string& source, const std::string& target, int scale) {
+    std::ifstream in(source);
+    std::ofstream out(target, std::ios::binary);
+    if (!in.is_open() || !out.is_open()) return 0;
+
+    std::string header;
+    std::getline(in, header);
+    std::string body;
+    std::string line;
+    size_t rows = 0;
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        body += line;
+        body += '\n';
+        rows++;
+    }
+
+    out << header << '\n';
+    for (int i = 0; i < scale; i++) out << body;
+    return rows * static_cast<size_t>(scale);
+}
+
+// Same rows with the tenor columns in reverse order and an extra 4MO column
+// appended, as a file from a different source might lay them out
+size_t writeReshapedCSV(const std::string& source, const std::string& target) {
+    std::ifstream in(source);
+    std::ofstream out(target, std::ios::binary);
+    if (!in.is_open() || !out.is_open()) return 0;
+
+    std::string line;
+    std::string reshaped;
+    size_t rows = 0;
+    for (bool header = true; std::getline(in, line); header = false) {
+        std::vector<std::string> fields;
+        std::istringstream iss(line);
+        std::string field;
+        while (std::getline(iss, field, ',')) fields.push_back(field);
+        if (fields.empty()) continue;
+
+        reshaped = fields[0];
+        for (size_t i = fields.size(); i-- > 1;) reshaped += ',' + fields[i];
+        reshaped += header ? ",4MO\n" : ",4.25\n";
+        out << reshaped;
+        rows += header ? 0 : 1;
+    }
+    return rows;
+}
+
+// The original YieldPoint, with its label copied into every point
+struct LegacyYieldPoint {
+    double maturity;
+    double yield;
+    std::string maturity_label;
+
+    LegacyYieldPoint(double m, double y, const std::string& label) : maturity(m), yield(y), maturity_label(label) {}
+};
+
+// Reference copy of the original getline/istringstream/stod loader, kept so
+// the mmap path can be measured against it.
+size_t legacyLoad(const std::string& filename, std::vector<LegacyYieldPoint>& points) {
+    std::ifstream file(filename);
+    std::string line;
+    std::getline(file, line);
+
+    const std::map<std::string, double> maturity_map = {
+        {"1MO", 1.0/12.0}, {"3MO", 0.25}, {"6MO", 0.5}, {"1Y", 1.0}, {"2Y", 2.0},
+        {"3Y", 3.0}, {"5Y", 5.0}, {"7Y", 7.0}, {"10Y", 10.0}, {"20Y", 20.0}, {"30Y", 30.0}
+    };
+
+    size_t rows = 0;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::istringstream iss(line);
+        std::string token;
+        std::vector<std::string> tokens;
+        while (std::getline(iss, token, ',')) {
+            tokens.push_back(token);
+        }
+        if (tokens.size() < 12) continue;
+
+        points.clear();
+        std::vector<std::string> maturity_order = {
+            "1MO", "3MO", "6MO", "1Y", "2Y", "3Y", "5Y", "7Y", "10Y", "20Y", "30Y"
+        };
+        for (size_t i = 0; i < maturity_order.size() && i + 1 < tokens.size(); i++) {
+            if (tokens[i + 1].empty()) continue;
+            points.emplace_back(maturity_map.at(maturity_order[i]), std::stod(tokens[i + 1]),
+                                maturity_order[i]);
+        }
+        rows++;
+    }
+    return rows;
+}
+
+// Reference copy of the original getYield: linear exact-match scan, then a
+// second linear scan for the bracketing segment with the slope recomputed.
+double legacyGetYield(const std::vector<YieldPoint>& points, double maturity) {
+    if (points.empty()) return 0.0;
+
+    for (const auto& point : points) {
+        if (std::abs(point.maturity - maturity) < 1e-6) return point.yield;
+    }
+    if (maturity <= points.front().maturity) return points.front().yield;
+    if (maturity >= points.back().maturity) return points.back().yield;
+
+    for (size_t i = 0; i < points.size() - 1; i++) {
+        if (points[i].maturity <= maturity && points[i + 1].maturity >= maturity) {
+            double x1 = points[i].maturity, x2 = points[i + 1].maturity;
+            if (std::abs(x2 - x1) < 1e-9) return points[i].yield;
+            return points[i].yield + (points[i + 1].yield - points[i].yield) * (maturity - x1) / (x2 - x1);
+        }
+    }
+    return 0.0;
+}
+
+void report(const std::string& name, size_t rows, double seconds, const char* unit = "rows/s") {
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms"
+              << std::setw(16) << std::setprecision(0) << rows / seconds << " " << unit << std::endl;
+}
+
+void reportThroughput(const std::string& name, size_t bytes, double seconds) {
+    std::cout << std::left << std::setw(28) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms"
+              << std::setw(16) << std::setprecision(1) << bytes / seconds / 1e6 << " MB/s" << std::endl;
+}
+
+// Random maturities across the whole curve, including both flat wings
+std::vector<double> randomMaturities(size_t count) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> dist(0.0, 35.0);
+    std::vector<double> maturities(count);
+    for (auto& t : maturities) t = dist(rng);
+    return maturities;
+}
+
+void benchmarkGetYield(const std::string& csv_file) {
+    std::cout << "\n=== getYield KERNEL ===" << std::endl;
+
+    YieldCurveLive curve;
+    if (!curve.loadFromCSV(csv_file)) return;
+
+    const size_t queries = 10000000;
+    std::vector<double> maturities = randomMaturities(queries);
+    const auto& points = curve.getYieldPoints();
+
+    double checksum = 0.0;
+    auto start = Clock::now();
+    for (double t : maturities) checksum += legacyGetYield(points, t);
+    report("linear scan (legacy)", queries, secondsSince(start), "evals/s");
+
+    double compiled_checksum = 0.0;
+    start = Clock::now();
+    for (double t : maturities) compiled_checksum += curve.getYield(t);
+    report("compiled curve", queries, secondsSince(start), "evals/s");
+
+    std::cout << "max |diff| per eval: " << std::scientific << std::setprecision(2)
+              << std::abs(checksum - compiled_checksum) / queries << std::fixed << std::endl;
+}
+
+void benchmarkBatchYields(const std::string& csv_file) {
+#if defined(__AVX512F__)
+    const char* kernel = "AVX-512";
+#elif defined(__AVX2__)
+    const char* kernel = "AVX2";
+#else
+    const char* kernel = "scalar";
+#endif
+    std::cout << "\n=== BATCH getYields (" << kernel << " kernel) ===" << std::endl;
+
+    YieldCurveLive curve;
+    if (!curve.loadFromCSV(csv_file)) return;
+
+    const size_t queries = 10000000;
+    std::vector<double> maturities = randomMaturities(queries);
+    std::vector<double> scalar(queries), batch(queries);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < queries; i++) scalar[i] = curve.getYield(maturities[i]);
+    report("scalar getYield loop", queries, secondsSince(start), "evals/s");
+
+    start = Clock::now();
+    curve.getYields(maturities.data(), batch.data(), queries);
+    report("getYields unsorted", queries, secondsSince(start), "evals/s");
+
+    double max_diff = 0.0;
+    for (size_t i = 0; i < queries; i++) max_diff = std::max(max_diff, std::abs(scalar[i] - batch[i]));
+
+    // Daily cash-flow schedule out to 30Y, already in ascending order
+    std::vector<double> schedule(queries);
+    for (size_t i = 0; i < queries; i++) schedule[i] = 30.0 * static_cast<double>(i) / queries;
+    start = Clock::now();
+    curve.getYields(schedule.data(), batch.data(), queries);
+    report("getYields sorted", queries, secondsSince(start), "evals/s");
+
+    for (size_t i = 0; i < queries; i++) {
+        max_diff = std::max(max_diff, std::abs(curve.getYield(schedule[i]) - batch[i]));
+    }
+    std::cout << "max |batch - scalar|: " << std::scientific << std::setprecision(2)
+              << max_diff << std::fixed << std::endl;
+
+    curve.setInterpolationMode(InterpolationMode::CubicSpline);
+    start = Clock::now();
+    for (size_t i = 0; i < queries; i++) scalar[i] = curve.getYield(maturities[i]);
+    report("spline getYield loop", queries, secondsSince(start), "evals/s");
+
+    start = Clock::now();
+    curve.getYields(maturities.data(), batch.data(), queries);
+    report("spline getYields", queries, secondsSince(start), "evals/s");
+
+    max_diff = 0.0;
+    for (size_t i = 0; i < queries; i++) max_diff = std::max(max_diff, std::abs(scalar[i] - batch[i]));
+    std::cout << "max |spline batch - scalar|: " << std::scientific << std::setprecision(2)
+              << max_diff << std::fixed << std::endl;
+}
+
+void benchmarkCsvIngestion(const std::string& csv_file, int scale) {
+    std::cout << "\n=== CSV INGESTION (" << scale << "x " << csv_file << ") ===" << std::endl;
+
+    const std::string scaled_file = "benchmark_scaled_yields.csv";
+    size_t rows = writeScaledCSV(csv_file, scaled_file, scale);
+    if (rows == 0) {
+        std::cerr << "Error: Could not prepare " << scaled_file << std::endl;
+        return;
+    }
+
+    std::vector<LegacyYieldPoint> points;
+    auto start = Clock::now();
+    legacyLoad(scaled_file, points);
+    report("getline + stod (legacy)", rows, secondsSince(start));
+
+    YieldCurveLive curve;
+    start = Clock::now();
+    curve.loadFromCSV(scaled_file);
+    report("latest curve (tail read)", rows, secondsSince(start));
+
+    // Tenors come from the constexpr table, so a curve owns no lookup map
+    const size_t constructions = 1000000;
+    size_t constructed = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < constructions; i++) {
+        YieldCurveLive empty;
+        constructed += empty.getYieldPoints().size() + 1;
+    }
+    report("YieldCurveLive constructor", constructed, secondsSince(start), "curves/s");
+
+    CurveHistory history;
+    history.setCacheEnabled(false);
+    start = Clock::now();
+    history.loadFromCSV(scaled_file);
+    report("columnar history", rows, secondsSince(start));
+
+    // Newline-aligned byte ranges parsed concurrently; every thread count
+    // must rebuild exactly the sequential history
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= cores; threads = threads < cores ? std::min(cores, threads * 2) : cores + 1) {
+        TaskScheduler scheduler(threads);
+        CurveHistory parallel;
+        parallel.setCacheEnabled(false);
+        start = Clock::now();
+        parallel.loadFromCSV(scaled_file, &scheduler);
+        report("  chunked, " + std::to_string(threads) + " thread(s)", rows, secondsSince(start));
+
+        bool same = parallel.size() == history.size();
+        for (size_t tenor = 0; same && tenor < kHistoryTenorCount; tenor++) {
+            same = std::memcmp(parallel.getColumn(tenor).data(), history.getColumn(tenor).data(),
+                               history.size() * sizeof(double)) == 0;
+        }
+        for (size_t row = 0; same && row < history.size(); row++) {
+            same = parallel.getDayNumber(row) == history.getDayNumber(row);
+        }
+        if (!same) std::cout << "MISMATCH against sequential load" << std::endl;
+    }
+
+    // Columns are resolved from the header once, so a reordered file with an
+    // extra tenor parses at the same rate into the same columns
+    const std::string reshaped_file = "benchmark_scaled_reshaped.csv";
+    if (writeReshapedCSV(scaled_file, reshaped_file) == rows) {
+        CurveHistory reshaped;
+        reshaped.setCacheEnabled(false);
+        start = Clock::now();
+        reshaped.loadFromCSV(reshaped_file);
+        report("reordered header + 4MO", rows, secondsSince(start));
+
+        bool same = reshaped.size() == history.size() && reshaped.hasTenor(findTenor("4MO"));
+        for (size_t tenor = 0; same && tenor < kHistoryTenorCount; tenor++) {
+            if (!history.hasTenor(tenor)) continue;
+            same = std::memcmp(reshaped.getColumn(tenor).data(), history.getColumn(tenor).data(),
+                               history.size() * sizeof(double)) == 0;
+        }
+        if (!same) std::cout << "MISMATCH against the original layout" << std::endl;
+    }
+    std::remove(reshaped_file.c_str());
+
+    // First cached load parses and writes the snapshot, the second maps it
+    const std::string cache_file = scaled_file + ".ycache";
+    std::remove(cache_file.c_str());
+    CurveHistory cached;
+    start = Clock::now();
+    cached.loadFromCSV(scaled_file);
+    report("history + cache rebuild", rows, secondsSince(start));
+
+    start = Clock::now();
+    cached.loadFromCSV(scaled_file);
+    report("history from cache", rows, secondsSince(start));
+
+    // Every row's points rebuilt from the columns, as loadFromHistory does
+    std::vector<YieldPoint> interned;
+    size_t point_count = 0;
+    start = Clock::now();
+    for (size_t row = 0; row < history.size(); row++) {
+        points.clear();
+        for (size_t i = 0; i < kHistoryTenorCount; i++) {
+            double yield = history.getYield(row, i);
+            if (!std::isnan(yield)) points.emplace_back(kHistoryTenorYears[i], yield, kHistoryTenorLabels[i]);
+        }
+        point_count += points.size();
+    }
+    report("points, string labels", point_count, secondsSince(start), "points/s");
+
+    point_count = 0;
+    start = Clock::now();
+    for (size_t row = 0; row < history.size(); row++) {
+        interned.clear();
+        for (size_t i = 0; i < kHistoryTenorCount; i++) {
+            double yield = history.getYield(row, i);
+            if (!std::isnan(yield)) interned.emplace_back(kHistoryTenorYears[i], yield, static_cast<TenorId>(i));
+        }
+        point_count += interned.size();
+    }
+    report("points, interned tenors", point_count, secondsSince(start), "points/s");
+    std::cout << "(sizeof YieldPoint " << sizeof(YieldPoint) << " bytes, with string label "
+              << sizeof(LegacyYieldPoint) << ")" << std::endl;
+
+    std::remove(cache_file.c_str());
+    std::remove(scaled_file.c_str());
+}
+
+// The previous parseCsvDouble: copy to a NUL-terminated buffer, then strtod
+bool strtodField(std::string_view field, double& value) {
+    char buffer[64];
+    if (field.empty() || field.size() >= sizeof(buffer)) return false;
+    std::memcpy(buffer, field.data(), field.size());
+    buffer[field.size()] = '\0';
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(buffer, &end);
+    return end != buffer && errno != ERANGE;
+}
+
+// The original loader's std::stod: a std::string per field, and an exception
+// for every "ND" or otherwise non-numeric field
+bool stodField(std::string_view field, double& value) {
+    try {
+        value = std::stod(std::string(field));
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// Per-field cost of each numeric parser over the yield fields of the real
+// file, with every tenth field replaced by an "ND" holiday marker
+void benchmarkFieldParsing(const std::string& csv_file) {
+    std::cout << "\n=== YIELD FIELD PARSING (" << csv_file << ") ===" << std::endl;
+
+    MappedFile file(csv_file);
+    if (!file.isOpen()) return;
+
+    std::vector<std::string_view> fields;
+    CsvLineReader reader(file.view());
+    std::string_view line;
+    reader.next(line);
+    CsvFields tokens;
+    while (reader.next(line)) {
+        splitCsvFields(line, tokens);
+        for (size_t i = 1; i < tokens.size(); i++) fields.push_back(tokens[i]);
+    }
+    if (fields.empty()) return;
+
+    std::vector<std::string_view> with_markers = fields;
+    for (size_t i = 0; i < with_markers.size(); i += 10) with_markers[i] = "ND";
+
+    const int passes = std::max<int>(1, static_cast<int>(2000000 / fields.size()));
+    auto measure = [&](const std::string& name, const std::vector<std::string_view>& input, auto parse) {
+        double sum = 0.0;
+        size_t parsed = 0;
+        auto start = Clock::now();
+        for (int pass = 0; pass < passes; pass++) {
+            for (std::string_view field : input) {
+                double value;
+                if (parse(field, value)) {
+                    sum += value;
+                    parsed++;
+                }
+            }
+        }
+        double seconds = secondsSince(start);
+        size_t count = input.size() * static_cast<size_t>(passes);
+        report(name, count, seconds, "fields/s");
+        std::cout << std::setw(40) << std::setprecision(1) << seconds * 1e9 / count << " ns/field, "
+                  << parsed << " parsed (checksum " << std::setprecision(1) << sum << ")" << std::endl;
+    };
+
+    auto from_chars_field = [](std::string_view field, double& value) {
+        return parseCsvValue(field, value) == CsvValueStatus::Ok;
+    };
+    measure("std::stod (legacy)", fields, stodField);
+    measure("strtod copy", fields, strtodField);
+    measure("from_chars", fields, from_chars_field);
+    measure("std::stod, 10% ND", with_markers, stodField);
+    measure("strtod copy, 10% ND", with_markers, strtodField);
+    measure("from_chars, 10% ND", with_markers, from_chars_field);
+}
+
+// Row and field splitting alone, with a plain newline scan as the floor
+void benchmarkTokenizer(const std::string& csv_file, int scale) {
+    std::cout << "\n=== CSV TOKENIZER (" << scale << "x " << csv_file << ") ===" << std::endl;
+
+    const std::string scaled_file = "benchmark_scaled_yields.csv";
+    if (writeScaledCSV(csv_file, scaled_file, scale) == 0) return;
+    MappedFile file(scaled_file);
+    std::remove(scaled_file.c_str());
+    if (!file.isOpen()) return;
+
+    std::string_view text = file.view();
+    size_t bytes = text.size();
+
+    // Touch every page first so all three runs read from memory
+    size_t newlines = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        newlines = 0;
+        auto start = Clock::now();
+        for (const char* p = text.data(); (p = static_cast<const char*>(
+                                               std::memchr(p, '\n', text.data() + bytes - p))) != nullptr;
+             p++) {
+            newlines++;
+        }
+        if (pass == 1) reportThroughput("memchr newline scan", bytes, secondsSince(start));
+    }
+
+    CsvFields fields;
+    std::string_view line;
+    size_t split_fields = 0;
+    auto start = Clock::now();
+    CsvLineReader lines(text);
+    while (lines.next(line)) {
+        splitCsvFields(line, fields);
+        split_fields += fields.size();
+    }
+    reportThroughput("line reader + split", bytes, secondsSince(start));
+
+    size_t indexed_fields = 0;
+    start = Clock::now();
+    CsvStructuralReader structural(text);
+    while (structural.next(line, fields)) indexed_fields += fields.size();
+#if defined(__AVX2__)
+    reportThroughput("structural index, AVX2", bytes, secondsSince(start));
+#elif defined(__SSE2__)
+    reportThroughput("structural index, SSE2", bytes, secondsSince(start));
+#else
+    reportThroughput("structural index, scalar", bytes, secondsSince(start));
+#endif
+
+    std::cout << "(" << newlines << " rows, " << indexed_fields << " fields"
+              << (indexed_fields == split_fields ? "" : ", MISMATCH against split") << ")" << std::endl;
+}
+
+// Reference copy of the original three-pow forward rate formula
+double legacyForwardRate(const YieldCurveLive& curve, double start_maturity, double end_maturity) {
+    if (end_maturity <= start_maturity) return 0.0;
+    double y1 = curve.getYield(start_maturity) / 100.0;
+    double y2 = curve.getYield(end_maturity) / 100.0;
+    double forward_rate = std::pow((std::pow(1 + y2, end_maturity) /
+                                   std::pow(1 + y1, start_maturity)),
+                                  1.0 / (end_maturity - start_maturity)) - 1.0;
+    return forward_rate * 100.0;
+}
+
+void benchmarkForwardRates(const std::string& csv_file) {
+    std::cout << "\n=== getForwardRate ===" << std::endl;
+
+    YieldCurveLive curve;
+    if (!curve.loadFromCSV(csv_file)) return;
+
+    // Random pairs plus pairs on published tenors (1y1y, 5y5y, ...)
+    const size_t queries = 5000000;
+    std::vector<double> starts = randomMaturities(queries);
+    std::vector<double> ends(queries);
+    for (size_t i = 0; i < queries; i++) ends[i] = starts[i] + 1.0 + std::fmod(starts[i] * 7.0, 10.0);
+
+    const double tenors[] = {1.0, 2.0, 3.0, 5.0, 7.0, 10.0, 20.0, 30.0};
+    std::vector<double> knot_starts(queries), knot_ends(queries);
+    for (size_t i = 0; i < queries; i++) {
+        knot_starts[i] = tenors[i % 4];
+        knot_ends[i] = tenors[4 + (i / 4) % 4];
+    }
+
+    double legacy = 0.0, cached = 0.0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < queries; i++) legacy += legacyForwardRate(curve, starts[i], ends[i]);
+    report("3x pow (legacy), random", queries, secondsSince(start), "fwds/s");
+
+    start = Clock::now();
+    for (size_t i = 0; i < queries; i++) cached += curve.getForwardRate(starts[i], ends[i]);
+    report("log-discount, random", queries, secondsSince(start), "fwds/s");
+
+    start = Clock::now();
+    for (size_t i = 0; i < queries; i++) legacy += legacyForwardRate(curve, knot_starts[i], knot_ends[i]);
+    report("3x pow (legacy), tenors", queries, secondsSince(start), "fwds/s");
+
+    start = Clock::now();
+    for (size_t i = 0; i < queries; i++) cached += curve.getForwardRate(knot_starts[i], knot_ends[i]);
+    report("log-discount, tenors", queries, secondsSince(start), "fwds/s");
+
+    std::cout << "mean |diff| per forward: " << std::scientific << std::setprecision(2)
+              << std::abs(legacy - cached) / (2.0 * queries) << std::fixed << std::endl;
+}
+
+void benchmarkForwardMatrix(const std::string& csv_file) {
+    std::cout << "\n=== forwardMatrix (monthly grid to 30Y) ===" << std::endl;
+
+    CurveHistory history;
+    if (!history.loadFromCSV(csv_file)) return;
+    YieldCurveLive curve;
+    if (!curve.loadFromHistory(history, history.latestRow())) return;
+
+    std::vector<double> grid = monthlyMaturityGrid();
+    size_t n = grid.size();
+    size_t pairs = n * (n - 1) / 2;
+    const int repeats = 50;
+
+    double checksum = 0.0;
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        for (size_t i = 0; i + 1 < n; i++) {
+            for (size_t j = i + 1; j < n; j++) checksum += legacyForwardRate(curve, grid[i], grid[j]);
+        }
+    }
+    report("3x pow (legacy) pairs", pairs * repeats, secondsSince(start), "fwds/s");
+
+    ForwardMatrix matrix;
+    start = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        curve.forwardMatrix(grid, matrix);
+        checksum -= matrix.rates[r % matrix.rates.size()];
+    }
+    report("forwardMatrix", pairs * repeats, secondsSince(start), "fwds/s");
+
+    double max_error = 0.0;
+    for (size_t i = 0; i + 1 < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            max_error = std::max(max_error, std::abs(matrix.at(i, j) - curve.getForwardRate(grid[i], grid[j])));
+        }
+    }
+    std::cout << "max |forwardMatrix - getForwardRate|: " << std::scientific << std::setprecision(2)
+              << max_error << std::fixed << " (checksum " << std::setprecision(1) << checksum << ")" << std::endl;
+
+    // Whole-history streaming, one matrix buffer in memory
+    const char* formats[] = {"binary", "CSV"};
+    ForwardExportFormat kinds[] = {ForwardExportFormat::Binary, ForwardExportFormat::CSV};
+    for (int f = 0; f < 2; f++) {
+        std::string file = f == 0 ? "benchmark_forwards.bin" : "benchmark_forwards.csv";
+        size_t curves = std::min<size_t>(history.size(), f == 0 ? history.size() : 50);
+        start = Clock::now();
+        size_t written = exportForwardMatrices(history, {history.size() - curves, history.size()}, grid, file, kinds[f]);
+        report(std::string("stream to ") + formats[f], written, secondsSince(start), "curves/s");
+
+        TaskScheduler scheduler;
+        start = Clock::now();
+        written = exportForwardMatrices(history, {history.size() - curves, history.size()}, grid, file, kinds[f],
+                                        InterpolationMode::Linear, &scheduler);
+        report(std::string("stream to ") + formats[f] + ", " + std::to_string(scheduler.workerCount()) + "w",
+               written, secondsSince(start), "curves/s");
+        std::remove(file.c_str());
+    }
+}
+
+void benchmarkHistoryAnalytics(const std::string& csv_file, int scale) {
+    std::cout << "\n=== WHOLE-HISTORY ANALYTICS (" << scale << "x " << csv_file << ") ===" << std::endl;
+
+    const std::string scaled_file = "benchmark_scaled_yields.csv";
+    if (writeScaledCSV(csv_file, scaled_file, scale) == 0) return;
+
+    CurveHistory history;
+    history.setCacheEnabled(false);
+    bool loaded = history.loadFromCSV(scaled_file);
+    std::remove(scaled_file.c_str());
+    if (!loaded) return;
+
+    // Thread counts 1, 2, 4, ... up to and including the core count
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < cores; threads *= 2) thread_counts.push_back(threads);
+    thread_counts.push_back(cores);
+
+    double checksum = 0.0;
+    for (unsigned threads : thread_counts) {
+        TaskScheduler scheduler(threads);
+        auto start = Clock::now();
+        HistoryAnalysisTable table = analyzeHistory(history, {0, history.size()}, scheduler);
+        report("analyzeHistory, " + std::to_string(threads) + " thread(s)", table.size(), secondsSince(start));
+        checksum += table.get(table.size() - 1, kMetricSpread2s10s);
+    }
+    std::cout << "(checksum " << std::setprecision(1) << checksum << ")" << std::endl;
+}
+
+// One trading day appended to a large history: tail-follow parses the new
+// line, a reload (cache off) parses the whole file again
+void benchmarkTailRefresh(const std::string& csv_file, int scale) {
+    std::cout << "\n=== TAIL REFRESH (" << scale << "x " << csv_file << ") ===" << std::endl;
+
+    const std::string scaled_file = "benchmark_scaled_yields.csv";
+    size_t rows = writeScaledCSV(csv_file, scaled_file, scale);
+    if (rows == 0) return;
+
+    TaskScheduler scheduler;
+    CurveHistory history;
+    history.setCacheEnabled(false);
+    if (!history.loadFromCSV(scaled_file, &scheduler)) return;
+
+    const int appends = 10;
+    double refresh_seconds = 0.0;
+    double reload_seconds = 0.0;
+    for (int i = 0; i < appends; i++) {
+        int32_t day = history.getDayNumber(history.latestRow()) + 1;
+        {
+            std::ofstream out(scaled_file, std::ios::app);
+            out << formatIsoDate(day) << ",4.1,4.0,3.8,3.6,3.5,3.5,3.6,3.8,4.0,4.6,4.6\n";
+        }
+
+        size_t first_changed;
+        auto start = Clock::now();
+        history.refreshFromCSV(scaled_file, first_changed, &scheduler);
+        refresh_seconds += secondsSince(start);
+
+        CurveHistory reloaded;
+        reloaded.setCacheEnabled(false);
+        start = Clock::now();
+        reloaded.loadFromCSV(scaled_file, &scheduler);
+        reload_seconds += secondsSince(start);
+
+        if (reloaded.size() != history.size() || first_changed != history.latestRow()) {
+            std::cout << "MISMATCH after append " << i << std::endl;
+        }
+    }
+    report("refreshFromCSV (1 row)", appends, refresh_seconds, "refreshes/s");
+    report("full reload", appends, reload_seconds, "reloads/s");
+
+    // What a follower pays on every poll while nothing is published
+    const int checks = 10000;
+    size_t first_changed;
+    auto start = Clock::now();
+    for (int i = 0; i < checks; i++) history.refreshFromCSV(scaled_file, first_changed, &scheduler);
+    report("unchanged file check", checks, secondsSince(start), "checks/s");
+    std::remove(scaled_file.c_str());
+}
+
+// The pre-JsonWriter exportToJSON body: one stream insertion per token with
+// the stream's default 6-digit formatting
+void legacyCurveJSON(std::ostream& file, const YieldCurveLive& curve) {
+    file << "{\n";
+    file << "  \"date\": \"" << curve.getDate() << "\",\n";
+    file << "  \"curve_shape\": \"" << curve.getCurveShape() << "\",\n";
+    file << "  \"yield_points\": [\n";
+    const auto& points = curve.getYieldPoints();
+    for (size_t i = 0; i < points.size(); i++) {
+        file << "    {\n";
+        file << "      \"maturity_label\": \"" << points[i].label() << "\",\n";
+        file << "      \"maturity_years\": " << points[i].maturity << ",\n";
+        file << "      \"yield\": " << points[i].yield << ",\n";
+        file << "      \"duration\": " << curve.getDuration(points[i].maturity) << "\n";
+        file << "    }";
+        if (i < points.size() - 1) file << ",";
+        file << "\n";
+    }
+    file << "  ],\n";
+    file << "  \"2s10s_bps\": " << curve.getSpread(2.0, 10.0) * 100 << ",\n";
+    file << "  \"5y5y\": " << curve.getForwardRate(5.0, 10.0) << "\n";
+    file << "}\n";
+}
+
+// Same fields as legacyCurveJSON, through JsonWriter
+void writerCurveJSON(JsonWriter& json, const YieldCurveLive& curve) {
+    json.beginObject();
+    json.key("date").string(curve.getDate());
+    json.key("curve_shape").string(curve.getCurveShape());
+    json.key("yield_points").beginArray();
+    for (const auto& point : curve.getYieldPoints()) {
+        json.beginObject();
+        json.key("maturity_label").string(point.label());
+        json.key("maturity_years").number(point.maturity);
+        json.key("yield").number(point.yield);
+        json.key("duration").number(curve.getDuration(point.maturity));
+        json.endObject();
+    }
+    json.endArray();
+    json.key("2s10s_bps").number(curve.getSpread(2.0, 10.0) * 100);
+    json.key("5y5y").number(curve.getForwardRate(5.0, 10.0));
+    json.endObject();
+    json.raw("\n");
+}
+
+void benchmarkJsonExport(const std::string& csv_file, int scale) {
+    std::cout << "\n=== JSON EXPORT (" << scale << "x " << csv_file << ") ===" << std::endl;
+
+    const std::string scaled_file = "benchmark_scaled_yields.csv";
+    if (writeScaledCSV(csv_file, scaled_file, scale) == 0) return;
+
+    CurveHistory history;
+    history.setCacheEnabled(false);
+    bool loaded = history.loadFromCSV(scaled_file);
+    std::remove(scaled_file.c_str());
+    if (!loaded) return;
+
+    // Curves are compiled up front so only serialization is timed
+    std::vector<YieldCurveLive> curves(std::min<size_t>(history.size(), 20000));
+    for (size_t i = 0; i < curves.size(); i++) curves[i].loadFromHistory(history, i);
+
+    std::ostringstream legacy;
+    auto start = Clock::now();
+    for (const auto& curve : curves) legacyCurveJSON(legacy, curve);
+    reportThroughput("ostream <<, per curve", legacy.str().size(), secondsSince(start));
+
+    std::string output;
+    start = Clock::now();
+    {
+        JsonWriter json(output);
+        for (const auto& curve : curves) writerCurveJSON(json, curve);
+    }
+    reportThroughput("JsonWriter, per curve", output.size(), secondsSince(start));
+
+    // One writer per curve, as the dashboard renders: each writer allocating
+    // its own buffer against all of them borrowing one scratch buffer
+    output.clear();
+    start = Clock::now();
+    for (const auto& curve : curves) {
+        JsonWriter json(output);
+        writerCurveJSON(json, curve);
+    }
+    reportThroughput("JsonWriter, writer per curve", output.size(), secondsSince(start));
+
+    std::vector<char> scratch;
+    output.clear();
+    start = Clock::now();
+    for (const auto& curve : curves) {
+        JsonWriter json(output, scratch);
+        writerCurveJSON(json, curve);
+    }
+    reportThroughput("JsonWriter, shared scratch", output.size(), secondsSince(start));
+
+    // Whole history through the chunked exporter, sequential and on every
+    // thread count; each output must match the sequential bytes
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    const std::pair<size_t, size_t> last_10k{history.size() > 10000 ? history.size() - 10000 : 0, history.size()};
+    for (HistoryJsonFormat format : {HistoryJsonFormat::Columns, HistoryJsonFormat::NDJSON}) {
+        const char* name = format == HistoryJsonFormat::Columns ? "columns" : "ndjson";
+        std::string reference;
+        start = Clock::now();
+        {
+            JsonWriter json(reference);
+            writeHistoryJSON(json, history, {0, history.size()}, format);
+        }
+        reportThroughput(std::string("history ") + name + ", inline", reference.size(), secondsSince(start));
+
+        for (unsigned threads = 1; threads <= cores; threads = threads < cores ? std::min(cores, threads * 2) : cores + 1) {
+            TaskScheduler scheduler(threads);
+            output.clear();
+            start = Clock::now();
+            {
+                JsonWriter json(output);
+                writeHistoryJSON(json, history, {0, history.size()}, format, &scheduler);
+            }
+            double seconds = secondsSince(start);
+            reportThroughput(std::string("history ") + name + ", " + std::to_string(threads) + " thread(s)",
+                             output.size(), seconds);
+            if (output != reference) std::cout << "MISMATCH against inline output" << std::endl;
+
+            std::ostringstream last;
+            start = Clock::now();
+            writeHistoryJSON(last, history, last_10k, format, &scheduler);
+            report(std::string("  last 10k dates, ") + name, last_10k.second - last_10k.first, secondsSince(start),
+                   "dates/s");
+        }
+    }
+
+    const std::string json_file = "benchmark_history.json";
+    TaskScheduler scheduler;
+    start = Clock::now();
+    size_t written = exportHistoryJSON(history, {0, history.size()}, json_file, HistoryJsonFormat::Columns, &scheduler);
+    report("exportHistoryJSON to file", written, secondsSince(start), "dates/s");
+    std::remove(json_file.c_str());
+}
+
+// The rows of live_yield_analysis.csv for a whole history: CSV written and
+// parsed back, against the binary column file written and mapped
+void benchmarkAnalysisColumns(const std::string& csv_file, int scale) {
+    std::cout << "\n=== ANALYSIS COLUMN FILE (" << scale << "x " << csv_file << ") ===" << std::endl;
+
+    const std::string scaled_file = "benchmark_scaled_yields.csv";
+    if (writeScaledCSV(csv_file, scaled_file, scale) == 0) return;
+
+    CurveHistory history;
+    history.setCacheEnabled(false);
+    bool loaded = history.loadFromCSV(scaled_file);
+    std::remove(scaled_file.c_str());
+    if (!loaded) return;
+
+    TaskScheduler scheduler;
+    auto start = Clock::now();
+    AnalysisColumns table = analyzeHistoryColumns(history, {0, history.size()}, scheduler);
+    report("analyzeHistoryColumns", table.size(), secondsSince(start));
+
+    const std::string text_file = "benchmark_analysis.csv";
+    start = Clock::now();
+    {
+        std::ofstream out(text_file);
+        out << "Analysis_Date,Data_Source,Maturity_Label,Maturity_Years,Yield_Pct,"
+            << "Duration,DV01,Forward_1Y,Risk_Level,Notes\n";
+        for (size_t i = 0; i < table.size(); i++) {
+            out << formatIsoDate(table.getDayNumber(i)) << "," << kAnalysisDataSource << ","
+                << kHistoryTenorLabels[table.getTenor(i)] << "," << table.get(i, kAnalysisMaturity) << ","
+                << table.get(i, kAnalysisYield) << "," << table.get(i, kAnalysisDuration) << ","
+                << table.get(i, kAnalysisDV01) << "," << table.get(i, kAnalysisForward1Y) << ","
+                << kRiskLevelLabels[table.getRisk(i)] << "," << kAnalysisNotes << "\n";
+        }
+    }
+    report("write CSV", table.size(), secondsSince(start));
+
+    const std::string column_file = "benchmark_analysis.ycol";
+    start = Clock::now();
+    table.writeFile(column_file);
+    report("write column file", table.size(), secondsSince(start));
+
+    // Read back the yield column both ways
+    double csv_sum = 0.0;
+    start = Clock::now();
+    {
+        MappedFile file(text_file);
+        std::string_view text = file.view();
+        size_t pos = text.find('\n') + 1;
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == std::string_view::npos) end = text.size();
+            std::string_view line = text.substr(pos, end - pos);
+            size_t field = 0;
+            for (int comma = 0; comma < 4; comma++) field = line.find(',', field) + 1;
+            double yield;
+            if (parseCsvDouble(line.substr(field, line.find(',', field) - field), yield)) csv_sum += yield;
+            pos = end + 1;
+        }
+    }
+    report("parse CSV, yield column", table.size(), secondsSince(start));
+
+    double column_sum = 0.0;
+    start = Clock::now();
+    {
+        AnalysisColumnsFile file;
+        if (file.open(column_file)) {
+            const double* yields = file.column(kAnalysisYield);
+            for (size_t i = 0; i < file.size(); i++) column_sum += yields[i];
+        }
+    }
+    report("map columns, verified", table.size(), secondsSince(start));
+
+    std::ifstream csv_size(text_file, std::ios::binary | std::ios::ate);
+    std::ifstream column_size(column_file, std::ios::binary | std::ios::ate);
+    std::cout << "CSV " << csv_size.tellg() / 1024 << " KB, column file " << column_size.tellg() / 1024
+              << " KB (checksum " << std::setprecision(1) << csv_sum - column_sum << ")" << std::endl;
+    std::remove(text_file.c_str());
+    std::remove(column_file.c_str());
+}
+
+// Dashboard endpoints without the socket: first render, cached body for a
+// new client, and an If-None-Match revalidation
+void benchmarkDashboardServer(const std::string& csv_file) {
+    std::cout << "\n=== DASHBOARD HTTP ENDPOINTS ===" << std::endl;
+
+    CurveHistory history;
+    if (!history.loadFromCSV(csv_file) || history.empty()) return;
+
+    const char* const targets[] = {"/curve", "/history", "/forwards?grid=0.25,0.5,1,2,3,5,7,10,20,30"};
+    const size_t iterations = 200;
+    for (const char* target : targets) {
+        DashboardHttpServer server(history, "docs");
+        std::string request = std::string("GET ") + target + " HTTP/1.1\r\nHost: localhost";
+        std::string response;
+
+        auto start = Clock::now();
+        server.handleRequest(request, response);
+        double cold = secondsSince(start);
+        size_t etag_pos = response.find("ETag: ");
+        std::string etag = response.substr(etag_pos + 6, response.find("\r\n", etag_pos) - etag_pos - 6);
+        size_t bytes = response.size();
+
+        start = Clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            response.clear();
+            server.handleRequest(request, response);
+        }
+        double cached = secondsSince(start) / iterations;
+
+        std::string revalidate = request + "\r\nIf-None-Match: " + etag;
+        start = Clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            response.clear();
+            server.handleRequest(revalidate, response);
+        }
+        double not_modified = secondsSince(start) / iterations;
+
+        std::string path(target, std::strcspn(target, "?"));
+        std::cout << std::left << std::setw(10) << path << std::right << std::setprecision(1)
+                  << " " << bytes / 1024.0 << " KB: render " << cold * 1e6 << " us, cached "
+                  << cached * 1e6 << " us, 304 " << not_modified * 1e6 << " us" << std::endl;
+    }
+}
+
+#if !defined(_WIN32)
+// Round-trip latency of the resident server: one client, one request in
+// flight, mixed query types over random dates so curves compile on demand
+void benchmarkQueryServer(const std::string& csv_file) {
+    std::cout << "\n=== QUERY SERVER ROUND TRIP ===" << std::endl;
+
+    CurveHistory history;
+    if (!history.loadFromCSV(csv_file) || history.empty()) return;
+
+    const std::string socket_path = "benchmark_query_server.sock";
+    CurveQueryServer server(history);
+    if (!server.listen(socket_path)) return;
+    std::thread server_thread([&server] { server.run(); });
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Error: Could not connect to " << socket_path << std::endl;
+        if (fd >= 0) ::close(fd);
+        server.stop();
+        server_thread.join();
+        return;
+    }
+
+    static const char* const templates[] = {"YIELD %s 0.25 2 5 10 30\n", "FORWARD %s 1 2 5 10\n",
+                                            "SPREAD %s 2 10 0.25 10\n", "SHAPE %s\n"};
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<size_t> row_dist(0, history.size() - 1);
+    const size_t requests = 100000;
+    std::vector<std::string> lines(requests);
+    char line[128];
+    for (size_t i = 0; i < requests; i++) {
+        std::snprintf(line, sizeof(line), templates[i % 4], history.getDate(row_dist(rng)).c_str());
+        lines[i] = line;
+    }
+
+    std::vector<double> latencies(requests);
+    char reply[4096];
+    size_t failures = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < requests; i++) {
+        auto sent = Clock::now();
+        if (::send(fd, lines[i].data(), lines[i].size(), 0) < 0) break;
+        ssize_t received = 0;
+        while (received == 0 || reply[received - 1] != '\n') {
+            ssize_t n = ::recv(fd, reply + received, sizeof(reply) - static_cast<size_t>(received), 0);
+            if (n <= 0) break;
+            received += n;
+        }
+        latencies[i] = std::chrono::duration<double, std::micro>(Clock::now() - sent).count();
+        if (received < 2 || reply[0] != 'O') failures++;
+    }
+    double total = secondsSince(start);
+
+    ::close(fd);
+    server.stop();
+    server_thread.join();
+    server.close();
+
+    std::sort(latencies.begin(), latencies.end());
+    report("query round trips", requests, total, "req/s");
+    std::cout << std::setprecision(1) << "latency p50 " << latencies[requests / 2] << " us, p99 "
+              << latencies[requests * 99 / 100] << " us, max " << latencies.back() << " us ("
+              << failures << " errors)" << std::endl;
+}
+#endif
+
+template <class Curve>
+void benchmarkPolicy(const std::string& name, const YieldCurveLive& source,
+                     const std::vector<double>& maturities, std::vector<double>& out) {
+    Curve curve(source);
+    auto start = Clock::now();
+    curve.getYields(maturities.data(), out.data(), maturities.size());
+    report(name, maturities.size(), secondsSince(start), "evals/s");
+}
+
+void benchmarkPolicies(const std::string& csv_file) {
+    std::cout << "\n=== BasicYieldCurve POLICIES ===" << std::endl;
+
+    YieldCurveLive curve;
+    if (!curve.loadFromCSV(csv_file)) return;
+
+    const size_t queries = 10000000;
+    std::vector<double> maturities = randomMaturities(queries);
+    std::vector<double> out(queries);
+
+    benchmarkPolicy<LinearYieldCurve>("linear", curve, maturities, out);
+    benchmarkPolicy<LogLinearDiscountYieldCurve>("log-linear discount", curve, maturities, out);
+    benchmarkPolicy<CubicSplineYieldCurve>("cubic spline", curve, maturities, out);
+    benchmarkPolicy<MonotoneConvexYieldCurve>("monotone convex", curve, maturities, out);
+    benchmarkPolicy<BasicYieldCurve<LinearInterpolation, LinearExtrapolation>>(
+        "linear + linear extrap", curve, maturities, out);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string csv_file = "treasury_yields_live.csv";
+    int scale = 1000;
+
+    if (argc > 1) csv_file = argv[1];
+    if (argc > 2) scale = std::max(1, std::atoi(argv[2]));
+
+    std::cout << "⚡ Live Treasury Yield Analyzer benchmarks" << std::endl;
+    benchmarkCsvIngestion(csv_file, scale);
+    benchmarkFieldParsing(csv_file);
+    benchmarkTokenizer(csv_file, scale);
+    benchmarkGetYield(csv_file);
+    benchmarkBatchYields(csv_file);
+    benchmarkPolicies(csv_file);
+    benchmarkForwardRates(csv_file);
+    benchmarkForwardMatrix(csv_file);
+    benchmarkHistoryAnalytics(csv_file, std::max(1, scale / 10));
+    benchmarkTailRefresh(csv_file, scale);
+    benchmarkJsonExport(csv_file, std::max(1, scale / 10));
+    benchmarkAnalysisColumns(csv_file, std::max(1, scale / 10));
+    benchmarkDashboardServer(csv_file);
+#if !defined(_WIN32)
+    benchmarkQueryServer(csv_file);
+#endif
+
+    return 0;
+}
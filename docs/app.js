@@ -398,17 +398,20 @@ class LiveYieldCurveDashboard {
     const refreshBtn = document.getElementById('refreshBtn');
     refreshBtn.classList.add('loading');
     
-    // Simulate Federal Reserve data refresh
-    setTimeout(() => {
+    // Pull the curve from the analyzer when served by `yield_analyzer_live http`,
+    // otherwise simulate a Federal Reserve data refresh
+    this.fetchLiveCurve().then(live => {
       // Update timestamp
       this.federalReserveData.marketStatus.last_update = new Date().toISOString();
       this.updateHeader();
       
-      // Simulate minor yield fluctuations (±2 basis points)
-      this.federalReserveData.liveTreasuryData.yield_points.forEach(point => {
-        const fluctuation = (Math.random() - 0.5) * 0.04; // ±2 basis points
-        point.yield = Math.max(0, point.yield + fluctuation);
-      });
+      if (!live) {
+        // Simulate minor yield fluctuations (±2 basis points)
+        this.federalReserveData.liveTreasuryData.yield_points.forEach(point => {
+          const fluctuation = (Math.random() - 0.5) * 0.04; // ±2 basis points
+          point.yield = Math.max(0, point.yield + fluctuation);
+        });
+      }
       
       // Update chart with new data
       if (this.chart) {
@@ -436,7 +439,23 @@ class LiveYieldCurveDashboard {
       setTimeout(() => {
         refreshBtn.innerHTML = originalContent;
       }, 2000);
-    }, 1500);
+    });
+  }
+
+  // Resolves true after replacing liveTreasuryData with the analyzer's /curve
+  // document. The server answers 304 via ETag when the curve is unchanged.
+  fetchLiveCurve() {
+    if (!window.location.protocol.startsWith('http')) {
+      return new Promise(resolve => setTimeout(() => resolve(false), 1500));
+    }
+    return fetch('/curve', { cache: 'no-cache' })
+      .then(response => response.ok ? response.json() : null)
+      .then(curve => {
+        if (!curve) return false;
+        Object.assign(this.federalReserveData.liveTreasuryData, curve);
+        return true;
+      })
+      .catch(() => false);
   }
 
   recalculateSpreads() {
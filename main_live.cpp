@@ -1,17 +1,30 @@
 #include "YieldCurveLive.h"
+#include "AnalysisColumns.h"
+#include "BatchCommands.h"
+#include "ForwardMatrixExport.h"
+#include "HistoryAnalytics.h"
+#include "TaskScheduler.h"
+#include <array>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <vector>
 #include <iomanip>
 #include <chrono>
+#include <cstdlib>
 #include <ctime>
 
 class LiveTreasuryAnalyzer {
 private:
+    CurveHistory history;
+    std::string history_file;
     YieldCurveLive curve;
+    InterpolationMode interpolation = InterpolationMode::Linear;
+    TaskScheduler scheduler;   // Shared by every parallel stage below
 
 public:
-    LiveTreasuryAnalyzer() = default;
+    // `workers` caps the threads this analyzer uses (0 = one per core)
+    explicit LiveTreasuryAnalyzer(unsigned workers = 0) : scheduler(workers) {}
 
     void displayWelcome() {
         std::cout << "\n" << std::string(60, '=') << std::endl;
@@ -27,21 +40,165 @@ public:
         std::cout << std::string(60, '-') << std::endl;
     }
 
-    bool initialize(const std::string& csv_file, const std::string& date = "") {
+    // Parse the CSV into the column store once; later calls only pick up
+    // rows appended to it since, keeping what is loaded if that fails
+    bool loadHistory(const std::string& csv_file) {
+        if (!history.empty() && csv_file == history_file) {
+            size_t curves = history.size();
+            size_t first_changed;
+            if (history.refreshFromCSV(csv_file, first_changed, &scheduler) && history.size() > curves) {
+                std::cout << "\n🔄 " << history.size() - curves << " new curves (latest "
+                          << history.getDate(history.latestRow()) << ")" << std::endl;
+            }
+            return true;
+        }
+
         std::cout << "\n📂 Loading live Treasury yield data..." << std::endl;
 
-        if (!curve.loadFromCSV(csv_file, date)) {
+        if (!history.loadFromCSV(csv_file, &scheduler)) {
             std::cerr << "❌ Failed to load yield curve data from " << csv_file << std::endl;
             std::cerr << "💡 Please ensure the file exists and contains valid Treasury data." << std::endl;
             return false;
         }
 
+        history_file = csv_file;
+        std::cout << "📚 Loaded " << history.size() << " curves ("
+                  << history.getDate(0) << " to " << history.getDate(history.latestRow()) << ")" << std::endl;
+        return true;
+    }
+
+    // Batch mode: one silent load, then the subcommand; returns the exit status
+    int runBatch(const BatchOptions& options) {
+        if (!history.loadFromCSV(options.csv_file, &scheduler)) {
+            std::cerr << "Error: Failed to load yield curve data from " << options.csv_file << std::endl;
+            return kBatchExitDataError;
+        }
+        history_file = options.csv_file;
+        return runBatchCommand(options, history, scheduler);
+    }
+
+    bool initialize(const std::string& csv_file, const std::string& date = "") {
+        if (!loadHistory(csv_file)) {
+            return false;
+        }
+
+        size_t row = history.latestRow();
+        if (!date.empty()) {
+            DateRange range;
+            if (!parseDateQuery(date, range)) {
+                std::cerr << "❌ Invalid date '" << date << "' (use YYYY-MM-DD, YYYY-MM, YYYY or YYYY-Qn)" << std::endl;
+                return false;
+            }
+
+            auto rows = history.findRange(range);
+            row = rows.first < rows.second ? rows.first : history.size();
+
+            // Weekends and holidays have no H.15 release; use the curve in force that day
+            if (row >= history.size() && range.single_day) {
+                row = history.findNearestPrior(range.first);
+                if (row < history.size()) {
+                    std::cout << "ℹ️  No curve published on " << date << ", using "
+                              << history.getDate(row) << std::endl;
+                }
+            }
+        }
+
+        if (row >= history.size() || !curve.loadFromHistory(history, row)) {
+            std::cerr << "❌ No yield curve data found for date " << date << std::endl;
+            return false;
+        }
+
         std::cout << "✅ Successfully loaded live Federal Reserve data!" << std::endl;
         std::cout << "📈 Curve Date: " << curve.getDate() << std::endl;
         std::cout << "🏛️  Shape: " << curve.getCurveShape() << std::endl;
         return true;
     }
 
+    const YieldCurveLive& getCurve() const { return curve; }
+
+    // Monthly 30Y forward grid for every curve in `query` ("all" for the
+    // whole history), streamed one date at a time
+    void exportForwardMatrices(const std::string& csv_file, const std::string& query, ForwardExportFormat format) {
+        if (!loadHistory(csv_file)) return;
+
+        std::pair<size_t, size_t> rows(0, history.size());
+        if (query != "all") {
+            DateRange range;
+            if (!parseDateQuery(query, range)) {
+                std::cerr << "❌ Invalid date '" << query << "' (use YYYY-MM-DD, YYYY-MM, YYYY, A..B or all)" << std::endl;
+                return;
+            }
+            rows = history.findRange(range);
+        }
+
+        std::string filename = format == ForwardExportFormat::Binary ? "live_forward_matrix.bin"
+                                                                     : "live_forward_matrix.csv";
+        size_t written = ::exportForwardMatrices(history, rows, monthlyMaturityGrid(), filename, format,
+                                                 interpolation, &scheduler);
+        if (written > 0) {
+            std::cout << "🧮 Forward matrices for " << written << " curves exported to " << filename << std::endl;
+        }
+    }
+
+    // Full analysis for every date in `query` ("all" for the whole history),
+    // parsed once and spread across all cores
+    void analyzeHistoryRange(const std::string& csv_file, const std::string& query) {
+        if (!loadHistory(csv_file)) return;
+
+        std::pair<size_t, size_t> rows(0, history.size());
+        if (query != "all") {
+            DateRange range;
+            if (!parseDateQuery(query, range)) {
+                std::cerr << "❌ Invalid date '" << query << "' (use YYYY-MM-DD, YYYY-MM, YYYY, A..B or all)" << std::endl;
+                return;
+            }
+            rows = history.findRange(range);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        HistoryAnalysisTable table = analyzeHistory(history, rows, scheduler, interpolation);
+        double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (table.empty()) {
+            std::cerr << "❌ No yield curve data found for " << query << std::endl;
+            return;
+        }
+
+        std::array<size_t, kCurveShapeCount> shape_counts{};
+        for (CurveShape shape : table.getShapes()) shape_counts[static_cast<size_t>(shape)]++;
+
+        std::cout << "\n📚 Analyzed " << table.size() << " curves ("
+                  << formatIsoDate(table.getDayNumber(0)) << " to "
+                  << formatIsoDate(table.getDayNumber(table.size() - 1)) << ") in "
+                  << std::fixed << std::setprecision(1) << elapsed_ms << " ms on "
+                  << scheduler.workerCount() << " worker(s)" << std::endl;
+        std::cout << "🏛️  Shapes:";
+        for (size_t i = 0; i < kCurveShapeCount; i++) {
+            if (shape_counts[i] > 0) {
+                std::cout << " " << curveShapeLabel(static_cast<CurveShape>(i)) << " " << shape_counts[i];
+            }
+        }
+        std::cout << std::endl;
+
+        if (table.exportCSV("live_history_analysis.csv")) {
+            std::cout << "📋 History analysis: live_history_analysis.csv" << std::endl;
+        }
+
+        AnalysisColumns columns = analyzeHistoryColumns(history, rows, scheduler, interpolation);
+        if (columns.writeFile("live_yield_analysis.ycol")) {
+            std::cout << "🗂️  Tenor analysis (" << columns.size() << " rows, binary columns): live_yield_analysis.ycol"
+                      << std::endl;
+        }
+    }
+
+    void setInterpolationMode(InterpolationMode mode) {
+        interpolation = mode;
+        curve.setInterpolationMode(mode);
+    }
+
+    // Header label -> maturity file; empty looks next to the CSV
+    void setTenorMappingFile(const std::string& mapping_file) { history.setTenorMappingFile(mapping_file); }
+
     void runFullAnalysis() {
         std::cout << "\n🔬 PERFORMING COMPREHENSIVE YIELD CURVE ANALYSIS..." << std::endl;
 
@@ -131,6 +288,7 @@ private:
 
         std::vector<double> key_maturities = {2.0, 5.0, 10.0, 30.0};
         std::vector<std::string> labels = {"2Y", "5Y", "10Y", "30Y"};
+        std::vector<double> yields = curve.getYields(key_maturities);
 
         std::cout << std::setw(8) << "Tenor" << std::setw(10) << "Yield%" 
                   << std::setw(12) << "Duration" << std::setw(10) << "DV01$" 
@@ -139,7 +297,7 @@ private:
 
         for (size_t i = 0; i < key_maturities.size(); i++) {
             double maturity = key_maturities[i];
-            double yield = curve.getYield(maturity);
+            double yield = yields[i];
             double duration = curve.getDuration(maturity);
             double dv01 = duration * 100; // Per $10,000 face value
 
@@ -229,13 +387,10 @@ private:
             double duration = curve.getDuration(point.maturity);
             double dv01 = duration * 100;
 
-            std::string risk_level = (duration < 2) ? "LOW" : 
-                                   (duration < 7) ? "MODERATE" : 
-                                   (duration < 15) ? "HIGH" : "VERY_HIGH";
+            std::string risk_level = kRiskLevelLabels[riskLevelCode(duration)];
+            std::string notes = kAnalysisNotes;
 
-            std::string notes = "Federal_Reserve_H15_Official_Data";
-
-            file << date << ",Federal_Reserve_H15," << point.maturity_label << "," 
+            file << date << "," << kAnalysisDataSource << "," << point.label() << ","
                  << point.maturity << "," << point.yield << ","
                  << duration << "," << dv01 << ","
                  << forward_1y << "," << risk_level << "," << notes << "\n";
@@ -259,8 +414,10 @@ void displayMainMenu() {
     std::cout << "6. 📋 Export Analysis Report (CSV)" << std::endl;
     std::cout << "7. 📊 Market Conditions Summary" << std::endl;
     std::cout << "8. ❌ Exit" << std::endl;
+    std::cout << "9. 🧮 Export Forward Rate Matrix (History)" << std::endl;
+    std::cout << "10. 📚 Analyze Full History (All Dates)" << std::endl;
     std::cout << std::string(50, '-') << std::endl;
-    std::cout << "👉 Enter your choice (1-8): ";
+    std::cout << "👉 Enter your choice (1-10): ";
 }
 
 void displayMarketSummary(const YieldCurveLive& curve) {
@@ -290,14 +447,29 @@ void displayMarketSummary(const YieldCurveLive& curve) {
 }
 
 int main(int argc, char* argv[]) {
-    LiveTreasuryAnalyzer analyzer;
-    std::string csv_filename = "treasury_yields_live.csv";
+    // Optional CSV file argument; --spline selects cubic spline interpolation,
+    // --threads N caps the worker threads (default: one per core). A leading
+    // subcommand (analyze, forward, spread, export) runs without the menu.
+    if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h")) {
+        printBatchUsage(std::cout);
+        return kBatchExitOk;
+    }
 
-    // Check if CSV file is provided as command line argument
-    if (argc > 1) {
-        csv_filename = argv[1];
+    BatchOptions options;
+    if (!parseBatchArguments(argc, argv, options)) {
+        printBatchUsage(std::cerr);
+        return kBatchExitUsage;
     }
 
+    LiveTreasuryAnalyzer analyzer(options.workers);
+    analyzer.setInterpolationMode(options.interpolation);
+    analyzer.setTenorMappingFile(options.mapping_file);
+    if (options.command != BatchCommand::None) {
+        return analyzer.runBatch(options);
+    }
+
+    std::string csv_filename = options.csv_file;
+
     analyzer.displayWelcome();
 
     int choice;
@@ -305,7 +477,12 @@ int main(int argc, char* argv[]) {
 
     while (running) {
         displayMainMenu();
-        std::cin >> choice;
+        if (!(std::cin >> choice)) {
+            if (std::cin.eof()) break;   // input closed, e.g. a piped caller ran out: leave as Exit would
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            choice = 0;
+        }
 
         switch (choice) {
             case 1: {
@@ -316,7 +493,7 @@ int main(int argc, char* argv[]) {
             }
 
             case 2: {
-                std::cout << "📅 Enter date (YYYY-MM-DD format): ";
+                std::cout << "📅 Enter date (YYYY-MM-DD, YYYY-MM or YYYY-Qn): ";
                 std::string date;
                 std::cin >> date;
 
@@ -334,9 +511,7 @@ int main(int argc, char* argv[]) {
                     std::cout << "📊 Enter end maturity (years): ";
                     std::cin >> end_mat;
 
-                    YieldCurveLive temp_curve;
-                    temp_curve.loadFromCSV(csv_filename);
-                    double forward = temp_curve.getForwardRate(start_mat, end_mat);
+                    double forward = analyzer.getCurve().getForwardRate(start_mat, end_mat);
 
                     std::cout << "🔮 Forward rate from " << start_mat << "Y to " 
                               << end_mat << "Y: " << std::setprecision(2) 
@@ -355,9 +530,7 @@ int main(int argc, char* argv[]) {
                     std::cout << "📊 Enter second maturity (years): ";
                     std::cin >> mat2;
 
-                    YieldCurveLive temp_curve;
-                    temp_curve.loadFromCSV(csv_filename);
-                    double spread = temp_curve.getSpread(mat1, mat2);
+                    double spread = analyzer.getCurve().getSpread(mat1, mat2);
 
                     std::cout << "📈 Yield spread (" << mat2 << "Y - " << mat1 
                               << "Y): " << std::setprecision(0) << spread * 100 
@@ -372,9 +545,7 @@ int main(int argc, char* argv[]) {
 
             case 5: {
                 if (analyzer.initialize(csv_filename)) {
-                    YieldCurveLive temp_curve;
-                    temp_curve.loadFromCSV(csv_filename);
-                    temp_curve.exportToJSON("live_yield_curve_data.json");
+                    analyzer.getCurve().exportToJSON("live_yield_curve_data.json");
                     std::cout << "🌐 Dashboard data exported successfully!" << std::endl;
                     std::cout << "📊 File: live_yield_curve_data.json" << std::endl;
                 }
@@ -390,9 +561,7 @@ int main(int argc, char* argv[]) {
 
             case 7: {
                 if (analyzer.initialize(csv_filename)) {
-                    YieldCurveLive temp_curve;
-                    temp_curve.loadFromCSV(csv_filename);
-                    displayMarketSummary(temp_curve);
+                    displayMarketSummary(analyzer.getCurve());
                 }
                 break;
             }
@@ -405,8 +574,31 @@ int main(int argc, char* argv[]) {
                 break;
             }
 
+            case 9: {
+                std::cout << "📅 Enter dates (YYYY-MM-DD, YYYY-MM, YYYY, A..B or all): ";
+                std::string query;
+                std::cin >> query;
+                std::cout << "💾 Output format (csv or bin): ";
+                std::string format;
+                std::cin >> format;
+
+                analyzer.exportForwardMatrices(csv_filename, query,
+                                               format == "bin" ? ForwardExportFormat::Binary
+                                                               : ForwardExportFormat::CSV);
+                break;
+            }
+
+            case 10: {
+                std::cout << "📅 Enter dates (YYYY-MM-DD, YYYY-MM, YYYY, A..B or all): ";
+                std::string query;
+                std::cin >> query;
+
+                analyzer.analyzeHistoryRange(csv_filename, query);
+                break;
+            }
+
             default: {
-                std::cout << "❌ Invalid choice. Please enter 1-8." << std::endl;
+                std::cout << "❌ Invalid choice. Please enter 1-10." << std::endl;
                 break;
             }
         }